@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Bytes a VM, an assembly or a board holds, charged against its cap and
+// every cap above it, see --vm-memory and friends. A budget gives back
+// what it still holds to the one above when it goes away.
+class Budget
+{
+    public:
+        // `limit` 0 for no cap
+        Budget(Budget* parent = nullptr, const std::uint64_t limit = 0) noexcept :
+            parent(parent),
+            limit(limit)
+        { }
+
+        Budget(const Budget&) = delete;
+        Budget& operator=(const Budget&) = delete;
+        ~Budget();
+
+        void SetLimit(const std::uint64_t limit) noexcept
+        { this->limit = limit; }
+
+        // Takes `bytes` here and all the way up, or nothing at all when
+        // that would go over a cap
+        bool Charge(const std::uint64_t bytes) noexcept;
+        void Release(const std::uint64_t bytes) noexcept;
+
+        // Whether Charge(bytes) would go through right now
+        bool Fits(const std::uint64_t bytes) const noexcept;
+
+        std::uint64_t Used() const noexcept
+        { return this->used.load(std::memory_order_relaxed); }
+
+        std::uint64_t Limit() const noexcept
+        { return this->limit; }
+
+    private:
+        Budget* const parent;
+        std::uint64_t limit;
+        std::atomic<std::uint64_t> used { 0 };
+};
@@ -1,15 +1,22 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 #include "CSRConfig.hpp"
+#include "budget.hpp"
 #include "message.hpp"
 #include "system.hpp"
 #include "bytemode/syscall.hpp"
 #include "bytemode/board.hpp"
 #include "bytemode/rom.hpp"
+#include "bytemode/stream.hpp"
+
+class JIT;
 
 using BoardCollection = std::unordered_map<sysbit_t, Board>;
 
@@ -34,6 +41,7 @@ class Assembly : IMessageObject
 
         Assembly() = delete;
         Assembly(AssemblySettings&& settings);
+        ~Assembly();
 
         const AssemblySettings& Settings() const noexcept 
         { return this->settings; }
@@ -41,17 +49,45 @@ class Assembly : IMessageObject
         const ROM& Rom() const noexcept 
         { return this->rom; }
 
+        const InstructionStream& Stream() const noexcept 
+        { return this->stream; }
+
         const BoardCollection& Boards() const noexcept 
         { return this->boards; }
 
+        // What the assembly and its boards hold, see --assembly-memory
+        Budget& Memory() noexcept
+        { return this->budget; }
+        const Budget& Memory() const noexcept
+        { return this->budget; }
+
+        // Native code for the stream, nullptr unless loaded with --jit
+        JIT* Jit() const noexcept
+#ifdef ENABLE_JIT
+        { return this->jit.get(); }
+#else
+        { return nullptr; }
+#endif
+
         Error DispatchMessages() noexcept override;
         Error ReceiveMessage(Message message) noexcept override;
         Error SendMessage(Message message) noexcept override;
 
         Error Load() noexcept;
+        // Settle, then runs each board once
         Error Run() noexcept;
+        // Dispatches the messages and asks the VM to shut the assembly
+        // down once it has no boards left
+        Error Settle() noexcept;
+        // Adds the boards to what the Scheduler runs this round
+        void Schedule(std::vector<Board*>& tasks) noexcept;
         Error AddBoard() noexcept;
+        // Adds `count` boards that start where board `id` is right now,
+        // sharing its RAM copy-on-write
+        Error CloneBoard(sysbit_t id, sysbit_t count) noexcept;
         Error RemoveBoard(sysbit_t id) noexcept;
+        // Board::DumpProfile for each board
+        void DumpProfiles() const noexcept;
 
         const std::string& Stringify() const noexcept;
 
@@ -59,12 +95,23 @@ class Assembly : IMessageObject
         { return this->syscallHandler; }
 
     private:
+        // outlives the boards, they give their bytes back to it
+        Budget budget;
         ROM rom { *this };
+        InstructionStream stream { rom };
         AssemblySettings settings;
         BoardCollection boards;
         class SysCallHandler syscallHandler;
+        // boards running on different workers message it at once
+        std::mutex receiving;
+#ifdef ENABLE_JIT
+        std::unique_ptr<JIT> jit;
+#endif
 
         mutable std::string reprStr;
 
         sysbit_t GenerateNewBoardID() const;
+        // Whether a new board holding `bytes` fits in the budgets, logs
+        // it if not
+        bool BoardFits(const std::uint64_t bytes) const noexcept;
 };
@@ -1,18 +1,19 @@
 #pragma once
 
 #include <ios>
+#include <memory>
 #include <string>
-#include <unordered_map>
 
 #include "bytemode/process.hpp"
+#include "bytemode/processtable.hpp"
+#include "bytemode/profile.hpp"
 #include "bytemode/cpu.hpp"
 #include "bytemode/ram.hpp"
+#include "budget.hpp"
 #include "CSRConfig.hpp"
 #include "message.hpp"
 #include "system.hpp"
 
-using ProcessCollection = std::unordered_map<uchar_t, Process>;
-
 class Assembly;
 
 class Board : IMessageObject
@@ -25,6 +26,8 @@ class Board : IMessageObject
         Board(Board&) = delete;
         Board(Board&&) = delete;
         Board(class Assembly& assembly, sysbit_t id);
+        // Picks up where `from` is, same processes, RAM out of `image`
+        Board(class Assembly& assembly, sysbit_t id, const Board& from, const RAM::Image& image);
 
         const class Assembly& Assembly() const 
         { return this->assembly; }
@@ -37,23 +40,63 @@ class Board : IMessageObject
         Error AddProcess() noexcept;
         Error RemoveProcess(uchar_t id) noexcept;
         Error Run() noexcept;
+        // Runs up to `times` times, stops early on an error or once the
+        // board has sent its assembly something to act on, see Scheduler
+        Error Run(const sysbit_t times) noexcept;
 
         const std::string& Stringify() const noexcept;
 
+        RAM::Image Snapshot() const noexcept
+        { return RAM::Image { this->ram }; }
+
+        // Logs what --profile recorded so far, nothing without it. The
+        // assembly does it when the board goes away.
+        void DumpProfile() const noexcept;
+
+        // NUMA node of the board's RAM, -1 unless --numa. Boards stay
+        // there unless they're migrated.
+        int Node() const noexcept
+        { return this->ram.Node(); }
+        bool Migrate(const int node) noexcept
+        { return this->ram.Migrate(node); }
+
+        // What the board holds, see --board-memory
+        const Budget& Memory() const noexcept
+        { return this->budget; }
+
         const Process& GetExecutingProcess() const noexcept
-        { return this->processes.at(this->currentProcess); }
+        { return this->processes[this->currentProcess]; }
 
         const sysbit_t id;
 
     private:
-        uchar_t GenerateNewProcessID() const;
-
-        ProcessCollection processes;
+        // What the executing process asks its board for from inside its
+        // Cycle, Run acts on it once the Cycle returns
+        enum class Request : uchar_t
+        {
+            None,
+            // quantum's up, on to the next runnable process
+            Switch,
+            // finished or failed, remove it
+            Exit
+        };
+
+        void Reschedule() noexcept;
+
+        ProcessTable processes;
         uchar_t currentProcess { 0 };
+        Request request { Request::None };
+        // cloned already or a clone itself, see --clones
+        bool forked { false };
+        // sent the assembly a message since Run(times) started
+        bool signalled { false };
 
         class Assembly& assembly;
+        Budget budget;
         RAM ram { *this };
         CPU cpu;
+        // nullptr unless --profile
+        std::unique_ptr<Profile> profile;
 
         mutable std::string reprStr;
 };
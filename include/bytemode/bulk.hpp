@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+
+// Kernels behind RAM's range operations. None of them check bounds, the
+// caller checks the whole range once. Fill and Swap run on the widest
+// vector unit the CPU has, picked the first time they're used.
+namespace Bulk
+{
+    // The ranges may overlap
+    void Copy(char* to, const char* from, std::size_t size) noexcept;
+
+    // Writes `pattern` `count` times back to back starting at `to`
+    void Fill(char* to, const char* pattern, std::size_t patternSize, std::size_t count) noexcept;
+
+    // Exchanges two ranges of `size` bytes, they must not overlap
+    void Swap(char* lhs, char* rhs, std::size_t size) noexcept;
+
+    void Zero(char* to, std::size_t size) noexcept;
+}
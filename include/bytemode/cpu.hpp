@@ -4,33 +4,55 @@
 
 #include "extensions/syntaxextensions.hpp"
 #include "bytemode/instructions.hpp"
+#include "bytemode/stream.hpp"
 #include "slice.hpp"
 #include "CSRConfig.hpp"
 #include "system.hpp"
 
 class Board;
+class JIT;
 
 class CPU
 {
+    friend class InstructionStream;
+    friend class JIT;
+
     public:
+        // Registers are kept in RegisterModeFlags order, so a register
+        // operand is an index into `wide` or `narrow`. The names alias
+        // the same slots.
         struct State
         {
-            sysbit_t eax { 0 };
-            sysbit_t ebx { 0 };
-            sysbit_t ecx { 0 };
-            sysbit_t edx { 0 };
-            sysbit_t esi { 0 };
-            sysbit_t edi { 0 };
-
-            sysbit_t pc { 0 };
-            sysbit_t sp { 0 };
-            sysbit_t bp { 0 };
-
-            uchar_t al { 0 };
-            uchar_t bl { 0 };
-            uchar_t cl { 0 };
-            uchar_t dl { 0 };
-            uchar_t flg { 0 };
+            union
+            {
+                struct
+                {
+                    sysbit_t eax;
+                    sysbit_t ebx;
+                    sysbit_t ecx;
+                    sysbit_t edx;
+                    sysbit_t esi;
+                    sysbit_t edi;
+
+                    sysbit_t pc;
+                    sysbit_t sp;
+                    sysbit_t bp;
+                };
+                sysbit_t wide[9] { };
+            };
+
+            union
+            {
+                struct
+                {
+                    uchar_t al;
+                    uchar_t bl;
+                    uchar_t cl;
+                    uchar_t dl;
+                    uchar_t flg;
+                };
+                uchar_t narrow[5] { };
+            };
         };
 
         CPU() = delete;
@@ -38,64 +60,141 @@ class CPU
         
         Error Cycle() noexcept;
 
+        // Runs the instruction at pc, then keeps going for at most `budget`
+        // instructions in total and leaves what's left of it in `budget`.
+        // Stops early on an error or right before a cal, calr, ret or
+        // anything else it can't execute, those are left for Cycle.
+        Error RunBurst(sysbit_t& budget) noexcept;
+
         const State& DumpState() const noexcept
         { return this->state; }
 
-        void LoadState(const State& loadFrom) noexcept
-        { this->state = loadFrom; }
+        void LoadState(const State& loadFrom) noexcept;
+
+        // The instruction at the current pc
+        const Instruction& Fetch() noexcept;
 
-        Error Push(const char value) noexcept;
-        Error Pop() noexcept;
+        // Safe = false skips the bounds checks, for runs the verifier
+        // has proven to fit the stack.
+        template<bool Safe = true> Error Push(const char value) noexcept;
+        template<bool Safe = true> Error Pop() noexcept;
 
-        Error PushSome(const Slice values) noexcept;
-        Error PopSome(const sysbit_t size) noexcept;
+        template<bool Safe = true> Error PushSome(const Slice values) noexcept;
+        template<bool Safe = true> Error PopSome(const sysbit_t size) noexcept;
 
     private: 
         Board& board;
         State state;
 
-        using OperationFunction = Error (*)(CPU& cpu) noexcept;
+        const InstructionStream& stream;
+        // decoded index of the instruction at state.pc
+        sysbit_t ip { InstructionStream::npos };
+        // holds instructions decoded on the fly, when pc isn't on the stream
+        Instruction scratch;
+
+        static const OperationFunction operations[Enumc(OpCodes::subsb)+1];
+
+        // Handlers that move pc on their own (dynamic jumps, returns, register
+        // writes) leave ip behind. Find where pc landed.
+        void Resync() noexcept
+        {
+            if (this->ip == InstructionStream::npos || this->stream[this->ip].pc != this->state.pc)
+                this->ip = this->stream.Locate(this->state.pc);
+        }
+
+        Error Failed(const Instruction& ins, Error code) noexcept;
 
-#define OPFunc(name) static Error name(CPU& cpu) noexcept;
-#define CustomOPF(ret, name, ...) static ret name(CPU& cpu, __VA_ARGS__) noexcept;
+        // Set when --verified is on, see InstructionStream::Verify
+        bool verified { false };
+
+        // Whether the run starting at `ins` stays within the stack
+        bool Fits(const Instruction& ins) const noexcept;
+
+        // Interprets from pc, leaves what's left of `budget` in it
+        Error Interpret(sysbit_t& budget) noexcept;
+
+        template<bool Safe>
+        Error Burst(sysbit_t& budget) noexcept;
+
+        // Typed stack access for the handlers, defined in instructions.cpp
+        // so they inline there. Values sit in RAM in RamEndian order, each call
+        // checks bounds once and loads or stores the RAM buffer in place.
+        // Peek reads the value `depth` bytes below sp and leaves it.
+        template<bool Safe = true> Error PushU32(const sysbit_t value) noexcept;
+        template<bool Safe = true> Error PushF32(const float value) noexcept;
+        template<bool Safe = true> Error PushU8(const uchar_t value) noexcept;
+        template<bool Safe = true> Error PopU32(sysbit_t& value) noexcept;
+        template<bool Safe = true> Error PopF32(float& value) noexcept;
+        template<bool Safe = true> Error PopU8(uchar_t& value) noexcept;
+        template<bool Safe = true> Error PeekU32(sysbit_t& value, const sysbit_t depth = 4) noexcept;
+        template<bool Safe = true> Error PeekF32(float& value, const sysbit_t depth = 4) noexcept;
+        template<bool Safe = true> Error PeekU8(uchar_t& value, const sysbit_t depth = 1) noexcept;
+
+        // Replaces the top T with op(top), or the top two with op(lhs, rhs)
+        // where rhs is the top. Keep leaves the operands and pushes the
+        // result above them instead.
+        template<typename T, bool Safe, bool Keep = false, typename Op>
+        Error Unary(Op op) noexcept;
+        template<typename T, bool Safe, bool Keep = false, typename Op>
+        Error Binary(Op op) noexcept;
+
+        template<typename T, bool Safe> Error PushValue(const T value) noexcept;
+        template<typename T, bool Safe> Error PeekValue(T& value, const sysbit_t depth) noexcept;
+        Error Overflow() const noexcept;
+
+#ifdef ENABLE_JIT
+        // Native code for the assembly's stream, nullptr without --jit
+        JIT* jit { nullptr };
+#endif
+
+#define OPFunc(name) static Error name(CPU& cpu, const Instruction& ins) noexcept;
+// Handlers whose stack accesses the verifier can prove, Safe = false
+// skips their bounds checks.
+#define StackOPFunc(name) template<bool Safe = true> static Error name(CPU& cpu, const Instruction& ins) noexcept;
+#define CustomOPF(ret, name, ...) static ret name(CPU& cpu, const Instruction& ins, __VA_ARGS__) noexcept;
 #define arr std::array
 #define fn std::function<sysbit_t(sysbit_t, sysbit_t)>
+        OPFunc(Fault)
         OPFunc(NoOperation)
-        OPFunc(StoreThirtyTwo) OPFunc(StoreEight) OPFunc(StoreFromSymbol)
-        OPFunc(LoadFromStack)
+        StackOPFunc(StoreThirtyTwo) StackOPFunc(StoreEight) StackOPFunc(StoreFromSymbol)
+        StackOPFunc(LoadFromStack)
         OPFunc(ReadFromHeap) OPFunc(ReadFromRegister)
         OPFunc(Move)
-        OPFunc(Add32) OPFunc(AddFloat) OPFunc(Add8)
+        StackOPFunc(Add32) StackOPFunc(AddFloat) StackOPFunc(Add8)
         OPFunc(AddReg)
-        OPFunc(AddSafe32) OPFunc(AddSafeFloat) OPFunc(AddSafe8)
+        StackOPFunc(AddSafe32) StackOPFunc(AddSafeFloat) StackOPFunc(AddSafe8)
         OPFunc(MemCopy)
-        OPFunc(Increment) OPFunc(IncrementReg) OPFunc(IncrementSafe)
-        OPFunc(Decrement) OPFunc(DecrementReg) OPFunc(DecrementSafe)
+        StackOPFunc(Increment) OPFunc(IncrementReg) StackOPFunc(IncrementSafe)
+        StackOPFunc(Decrement) OPFunc(DecrementReg) StackOPFunc(DecrementSafe)
         CustomOPF(Error, BitLogic, arr<OpCodes, 3>, fn) OPFunc(BitAnd) OPFunc(BitOr) OPFunc(BitNor)
-        OPFunc(SwapTop)
-        OPFunc(DuplicateTop)
-        OPFunc(RawDataStack)
-        OPFunc(Invert) OPFunc(InvertSafe)
-        OPFunc(Compare)
-        OPFunc(PopInstruction)
-        OPFunc(Jump)
+        StackOPFunc(SwapTop)
+        StackOPFunc(DuplicateTop)
+        StackOPFunc(RawDataStack)
+        StackOPFunc(Invert) StackOPFunc(InvertSafe)
+        StackOPFunc(Compare)
+        StackOPFunc(PopInstruction)
+        StackOPFunc(Jump)
         OPFunc(SwapRange) OPFunc(DuplicateRange)
         OPFunc(Repeat)
         OPFunc(Allocate)
-        OPFunc(PowRegister) OPFunc(PowStack) OPFunc(PowConst)
-        OPFunc(SqrtRegister) OPFunc(SqrtStack) OPFunc(SqrtConst)
-        OPFunc(ConditionalJump)
+        OPFunc(PowRegister) StackOPFunc(PowStack) StackOPFunc(PowConst)
+        OPFunc(SqrtRegister) StackOPFunc(SqrtStack) StackOPFunc(SqrtConst)
+        StackOPFunc(ConditionalJump)
         OPFunc(CallFunc)
-        OPFunc(MulStack) OPFunc(MulRegister)  OPFunc(MulSafe)
-        OPFunc(DivStack) OPFunc(DivRegister)  OPFunc(DivSafe)
+        StackOPFunc(MulStack) OPFunc(MulRegister)  StackOPFunc(MulSafe)
+        StackOPFunc(DivStack) OPFunc(DivRegister)  StackOPFunc(DivSafe)
         OPFunc(Return)
         OPFunc(Deallocate)
-        OPFunc(Sub32) OPFunc(SubFloat) OPFunc(Sub8)
+        StackOPFunc(Sub32) StackOPFunc(SubFloat) StackOPFunc(Sub8)
         OPFunc(SubReg)
-        OPFunc(SubSafe32) OPFunc(SubSafeFloat) OPFunc(SubSafe8)
+        StackOPFunc(SubSafe32) StackOPFunc(SubSafeFloat) StackOPFunc(SubSafe8)
+
+        // Superinstructions, see InstructionStream::Fuse
+        OPFunc(FoldedConstant) OPFunc(CompareJump) OPFunc(SysCallPrologue)
 
 #undef fn
 #undef arr
 #undef CustomOPF
+#undef StackOPFunc
 #undef OPFunc
 };
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "bytemode/heap.hpp"
+#include "CSRConfig.hpp"
+
+// Where the blocks `alc` hands out in --handles mode are right now. The
+// address space past the stack is split into pages and each block gets
+// a run of them, first fit, so a heap address is a page and how far into
+// the block it points. RAM can move a block by updating where it is and
+// the program never notices. Addresses here are relative to the start of
+// the heap.
+class Handles
+{
+    public:
+        struct Block
+        {
+            sysbit_t offset { 0 };
+            // 0 for a free slot
+            sysbit_t size { 0 };
+            // first page of its addresses
+            sysbit_t page { 0 };
+        };
+
+        Handles() = default;
+        // `span` is the address space past the stack
+        Handles(const std::uint64_t span);
+        Handles(const Handles& other);
+        Handles(Handles&&) = default;
+        Handles& operator=(Handles&&) = default;
+
+        // Takes addresses for a block at `offset`, false when there
+        // aren't enough pages left in a row
+        bool Add(const sysbit_t offset, const sysbit_t size, sysbit_t& address);
+        void Remove(const sysbit_t slot) noexcept;
+
+        // The slot `address` points into and how far into its block,
+        // false unless [address, address+size) lies in a live block
+        bool Resolve(const sysbit_t address, const std::uint64_t size, sysbit_t& slot, sysbit_t& into) const noexcept
+        {
+            const sysbit_t page { address >> PageBits };
+            if (page >= this->table.size() || this->table[page] == 0)
+                return false;
+
+            slot = this->table[page]-1;
+            const Block& block { this->blocks[slot] };
+            into = address-(block.page << PageBits);
+            return into < block.size && size <= block.size-into;
+        }
+
+        Block& operator[](const sysbit_t slot) noexcept
+        { return this->blocks[slot]; }
+        const Block& operator[](const sysbit_t slot) const noexcept
+        { return this->blocks[slot]; }
+
+        // Live slots in the order of their blocks' offsets
+        std::vector<sysbit_t> ByOffset() const;
+
+    private:
+        static constexpr sysbit_t PageBits { 8 };
+
+        std::vector<Block> blocks;
+        std::vector<sysbit_t> unused;
+        // which pages are taken
+        Heap pages;
+        // slot+1 of the block each page belongs to, 0 for none. First
+        // fit keeps it short.
+        std::vector<sysbit_t> table;
+
+        static sysbit_t PagesOf(const sysbit_t size) noexcept
+        { return std::max<sysbit_t>(1, (size >> PageBits)+((size & ((1u << PageBits)-1)) != 0)); }
+};
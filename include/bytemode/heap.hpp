@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "CSRConfig.hpp"
+#include "platform.hpp"
+
+// Tracks which heap cells are in use, one bit per cell. The bitmap is
+// read 64 cells at a time and summarised in a tree over blocks of it,
+// each node knowing the longest free run in its range and the free runs
+// touching its ends. Finding the first fit walks down the tree, so an
+// allocation costs O(log heap) no matter how fragmented the heap is, and
+// freed runs merge with their neighbours on their own.
+//
+// Both live on pages of their own that start out zeroed, and zero means
+// free, so a fresh heap doesn't touch the pages under its bookkeeping
+// until it's used.
+class Heap
+{
+    public:
+        Heap() = default;
+        Heap(sysbit_t size);
+
+        // A frozen copy of a heap's bookkeeping, heaps made from it share
+        // its pages copy-on-write, see RAM::Image
+        class Image
+        {
+            public:
+                Image(const Heap& source) noexcept;
+                Image(const Image&) = delete;
+                ~Image();
+
+                const Heap& source;
+                const memsnap_t map;
+                const memsnap_t tree;
+        };
+
+        Heap(const Image& image);
+        Heap(Heap&&) = default;
+        Heap& operator=(Heap&&) = default;
+
+        // Marks the lowest `size` free cells in a row as used and puts
+        // their offset in `offset`. False if there's no such run.
+        bool Allocate(const sysbit_t size, sysbit_t& offset) noexcept;
+
+        // Marks [offset, offset+size) free, used or not
+        void Free(const sysbit_t offset, const sysbit_t size) noexcept;
+
+        // Extends the heap to `size` cells, the new ones are free
+        void Grow(const sysbit_t size) noexcept;
+
+        // Free cells in a row at the end of the heap
+        sysbit_t FreeTail() const noexcept;
+
+        sysbit_t Size() const noexcept
+        { return this->size; }
+
+        sysbit_t FreeCells() const noexcept
+        { return this->freeCells; }
+
+        // Longest run of free cells anywhere
+        sysbit_t LargestRun() const noexcept;
+
+    private:
+        // Free runs of a range, in cells
+        struct Runs
+        {
+            sysbit_t head { 0 };
+            sysbit_t tail { 0 };
+            sysbit_t longest { 0 };
+        };
+
+        struct Release
+        {
+            std::size_t size;
+            void operator()(void* memory) const noexcept;
+        };
+
+        // `count` zeroed T on whole pages, nullptr if there's no memory
+        template<typename T>
+        static std::unique_ptr<T[], Release> Pages(const std::size_t count) noexcept;
+
+        // Words of the bitmap under each leaf of the tree
+        static constexpr sysbit_t LeafWords { 16 };
+        static constexpr sysbit_t LeafCells { LeafWords*64 };
+
+        std::unique_ptr<std::uint64_t[], Release> map;
+        // 1-based, leaves start at `leaves`. Nodes hold how far their
+        // runs fall short of the cells under them, see Node.
+        std::unique_ptr<Runs[], Release> tree;
+        sysbit_t size { 0 };
+        sysbit_t words { 0 };
+        sysbit_t leaves { 0 };
+        sysbit_t freeCells { 0 };
+        // words of the map ever written, the rest are still zero
+        sysbit_t touched { 0 };
+
+        // Sizes the tree for `size` cells and summarises the leaves over
+        // the first `used` cells and the last one, the rest are free
+        void Build(const sysbit_t used) noexcept;
+
+        // `span` is how many cells the node covers
+        Runs Node(const sysbit_t node, const std::uint64_t span) const noexcept;
+        void SetNode(const sysbit_t node, const std::uint64_t span, const Runs& runs) noexcept;
+
+        Runs Summarise(const sysbit_t leaf) const noexcept;
+        sysbit_t FindInLeaf(const sysbit_t leaf, const sysbit_t size) const noexcept;
+        // Sets or clears the bits of [offset, offset+size), returns how many changed
+        sysbit_t Mark(const sysbit_t offset, const sysbit_t size, const bool used) noexcept;
+        // Resummarises the leaves under [offset, offset+size), size > 0
+        void Update(const sysbit_t offset, const sysbit_t size) noexcept;
+        // Recombines the ancestors of leaf nodes low..high up to the root
+        void Propagate(sysbit_t low, sysbit_t high) noexcept;
+};
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <limits>
+
 #include "extensions/syntaxextensions.hpp"
 #include "CSRConfig.hpp"
+#include "system.hpp"
 
 constexpr uchar_t NoMode = 0x00;
 
@@ -30,6 +33,9 @@ MAKE_ENUM(MemoryModeFlags, Stack, 6, MEMOR, OUT_CLASS)
 MAKE_ENUM(RegisterModeFlags, eax, 8, REGOR, OUT_CLASS)
 #undef REGOR
 
+#define Enumc(regn) static_cast<char>(regn)
+#define Is8BitReg(reg) (Enumc(reg) >= Enumc(RegisterModeFlags::al)) && (Enumc(reg) <= Enumc(RegisterModeFlags::flg))
+
 #define CMPER(E) \
     E(gre) E(equ) E(leq) E(geq) E(neq) 
 MAKE_ENUM(CompareModeFlags, les, 21, CMPER, OUT_CLASS)
@@ -71,3 +77,62 @@ MAKE_ENUM(CompareModeFlags, les, 21, CMPER, OUT_CLASS)
 MAKE_ENUM(OpCodes, nop, 0, OPER, OUT_CLASS)
 #undef OPER
 
+class CPU;
+struct Instruction;
+
+using OperationFunction = Error (*)(CPU& cpu, const Instruction& ins) noexcept;
+
+// An instruction decoded once from the ROM. Operands are unpacked at load
+// time so handlers never go back to the ROM while executing.
+struct Instruction
+{
+    // Dispatch slots CPU::RunBurst uses besides the opcodes themselves.
+    // Generic goes through the handler pointer and resyncs pc afterwards,
+    // Yield ends the burst before the instruction runs.
+    static constexpr uchar_t Generic { Enumc(OpCodes::subsb)+1 };
+    static constexpr uchar_t Yield { Enumc(OpCodes::subsb)+2 };
+    // stackNeed of an instruction that must never run unchecked
+    static constexpr sysbit_t Unproven { std::numeric_limits<sysbit_t>::max() };
+
+    OperationFunction handler { nullptr };
+
+    // raw operand bytes inside the ROM, for instructions that copy them
+    // as they are (stt, ste, stts, stes, raw, raws, rep)
+    const char* data { nullptr };
+
+    // ROM address of the opcode and of the next instruction
+    sysbit_t pc { 0 };
+    sysbit_t next { 0 };
+
+    // decoded index of the instruction at `next`, and of a static jump/call
+    // target. InstructionStream::npos if there is none.
+    sysbit_t follow { 0 };
+    sysbit_t target { 0 };
+
+    sysbit_t imm { 0 };
+    sysbit_t imm2 { 0 };
+
+    OpCodes op { OpCodes::nop };
+    uchar_t mode { 0 };
+    uchar_t reg1 { 0 };
+    uchar_t reg2 { 0 };
+
+    // the opcode, or one of the slots above
+    uchar_t dispatch { Yield };
+
+    // Set by InstructionStream::Verify when the instruction at `follow` is
+    // part of the same straight-line run.
+    bool chained { false };
+
+    // Stack effect of the run starting here, from InstructionStream::Verify.
+    // The run reads at most stackNeed bytes below sp and never pushes more
+    // than stackGrow bytes above it. Instructions the verifier didn't see
+    // keep a need no stack can meet.
+    sysbit_t stackNeed { Unproven };
+    sysbit_t stackGrow { 0 };
+
+    // SysCallHandler slot a cal's operand was linked to, see
+    // InstructionStream::Link. Unlinked for anything decoded on the fly.
+    static constexpr sysbit_t Unlinked { std::numeric_limits<sysbit_t>::max() };
+    sysbit_t slot { Unlinked };
+};
@@ -13,8 +13,7 @@ class Process : IMessageObject
         Process() = delete;
         Process(Process&) = delete;
         Process(Process&&) = delete;
-        Process(Board& parent, uchar_t id) : board(parent), id(id)
-        { }
+        Process(Board& parent, uchar_t id);
 
         Error DispatchMessages() noexcept override;
         Error ReceiveMessage(Message message) noexcept override;
@@ -28,13 +27,26 @@ class Process : IMessageObject
         void LoadState(const CPU::State& loadFrom) noexcept
         { this->state = loadFrom; }
 
+        // Runs until a call or return, an error, the end of a burst or
+        // the end of its quantum, which hands the board to the next process
         Error Cycle() noexcept;
 
+        // Instructions the process runs before it's preempted, --quantum
+        // unless set otherwise
+        sysbit_t Quantum() const noexcept
+        { return this->quantum; }
+        void SetQuantum(const sysbit_t quantum) noexcept
+        { this->quantum = this->left = quantum != 0 ? quantum : 1; }
+
         const uchar_t id;
 
     private:
         Board& board;
         CPU::State state;
 
+        sysbit_t quantum;
+        // what's left of the quantum
+        sysbit_t left;
+
         mutable std::string reprStr;
 };
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include "bytemode/process.hpp"
+#include "CSRConfig.hpp"
+
+class Board;
+
+// A board's processes by id. There are only 256 ids so every one gets a
+// slot up front, a lookup is an index and a bitmap says which ids are
+// taken. The runnable processes are linked into a ring through their
+// slots, the board walks it round-robin.
+class ProcessTable
+{
+    public:
+        static constexpr sysbit_t Capacity { 256 };
+
+        ProcessTable() = default;
+        ProcessTable(ProcessTable&) = delete;
+        void operator=(ProcessTable const&) = delete;
+
+        bool Contains(const sysbit_t id) const noexcept
+        { return id < Capacity && (this->used[id/64] >> (id%64) & 1) != 0; }
+
+        sysbit_t Size() const noexcept
+        { return this->count; }
+
+        // Lowest free id, Capacity once they're all taken
+        sysbit_t FreeId() const noexcept;
+
+        Process& operator[](const uchar_t id) noexcept
+        { return *this->slots[id].process; }
+        const Process& operator[](const uchar_t id) const noexcept
+        { return *this->slots[id].process; }
+
+        // Makes process `id` and links it into the ring right before
+        // `before`, last in line after it. The first one is a ring of its own.
+        Process& Emplace(const uchar_t id, const uchar_t before, Board& board);
+        // Unlinks and destroys process `id`
+        void Erase(const uchar_t id) noexcept;
+
+        // The one after `id` in the ring, `id` itself if it's alone
+        uchar_t Next(const uchar_t id) const noexcept
+        { return this->slots[id].next; }
+
+    private:
+        struct Slot
+        {
+            std::optional<Process> process;
+            uchar_t next { 0 };
+            uchar_t prev { 0 };
+        };
+
+        std::array<Slot, Capacity> slots;
+        std::array<std::uint64_t, Capacity/64> used { };
+        sysbit_t count { 0 };
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include "CSRConfig.hpp"
+
+class RAM;
+
+// What a board does with its memory, see --profile. Heap numbers are
+// exact, the stack is sampled wherever the board gets control back, so
+// before every cal, calr and ret and at the end of each burst.
+class Profile
+{
+    public:
+        // `alc` at `pc` got `size` bytes at `address`, or failed
+        void Allocated(const RAM& ram, const sysbit_t pc, const sysbit_t address, const sysbit_t size);
+        void Failed(const sysbit_t pc);
+        // `del` of [address, address+size), blocks it covers are dead
+        void Freed(const sysbit_t address, const sysbit_t size);
+
+        void Stack(const sysbit_t sp) noexcept
+        {
+            if (sp > this->stackPeak)
+                this->stackPeak = sp;
+        }
+
+        // Logs everything under `name`
+        void Dump(const std::string& name, const RAM& ram) const;
+
+    private:
+        // `alc` instructions by their pc
+        struct Site
+        {
+            sysbit_t blocks { 0 };
+            std::uint64_t bytes { 0 };
+            sysbit_t failed { 0 };
+            sysbit_t liveBlocks { 0 };
+            std::uint64_t liveBytes { 0 };
+        };
+
+        struct Block
+        {
+            sysbit_t pc;
+            sysbit_t size;
+        };
+
+        std::unordered_map<sysbit_t, Site> sites;
+        // live blocks by address
+        std::map<sysbit_t, Block> blocks;
+        sysbit_t stackPeak { 0 };
+        sysbit_t heapPeak { 0 };
+        sysbit_t frees { 0 };
+};
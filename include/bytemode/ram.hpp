@@ -1,5 +1,13 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "bytemode/handles.hpp"
+#include "bytemode/heap.hpp"
+#include "budget.hpp"
+#include "platform.hpp"
 #include "slice.hpp"
 #include "CSRConfig.hpp"
 #include "system.hpp"
@@ -10,43 +18,86 @@ class RAM
 {
     public:
         RAM(const Board& board) :
-            allocationMap(nullptr),
             data(nullptr),
             stackSize(0),
             heapSize(0),
             board(board)
         { }
 
-        RAM(sysbit_t stackSize, sysbit_t heapSize, const Board& board) :
-            stackSize(stackSize),
-            heapSize(heapSize),
-            data(std::make_unique_for_overwrite<char[]>(stackSize+heapSize)),
-            allocationMap(std::make_unique<uchar_t[]>(heapSize/8)),
-            board(board)
+        // How pages are backed, see --prefault, --huge-pages and --numa
+        struct Paging
+        {
+            bool prefault;
+            bool hugePages;
+            // NUMA node the pages go on, -1 for wherever they're touched
+            int node { -1 };
+        };
+
+        // Reserves address space for the heap to grow up to `heapLimit`
+        // and only backs what's in use. A limit at or below `heapSize`
+        // keeps the heap at its size. Pages cost nothing until touched
+        // unless `paging` says otherwise. With `handled` heap addresses
+        // go through a Handles table and blocks move to make room. What's
+        // backed is charged to `budget`.
+        RAM(sysbit_t stackSize, sysbit_t heapSize, sysbit_t heapLimit, Paging paging, bool handled, Budget& budget, const Board& board);
+
+        // Bytes a RAM backs when it's made
+        static std::size_t Footprint(const sysbit_t stackSize, const sysbit_t heapSize) noexcept;
+
+        // A frozen copy of a RAM's contents, taken when it's made. RAMs
+        // made from it map its pages copy-on-write, so each one only pays
+        // for the pages it writes. `source` must not change while it's alive.
+        class Image
         {
-            // allocation map will hold 1 bit for each cell. 
-            // so each byte refers to 8 cells. heap size must
-            // be multiple of 8
-#ifndef NDEBUG
-            if (heapSize % 8 != 0)
-                CRASH(
-                    Error::Bad,
-                    "heap size must be a multiple of 8."
-                );
-#endif
-        }
+            public:
+                Image(const RAM& source) noexcept;
+                Image(const Image&) = delete;
+                ~Image();
+
+                const RAM& source;
+                const memsnap_t snapshot;
+                const Heap::Image heap;
+        };
+
+        RAM(const Image& image, Budget& budget, const Board& board);
 
         RAM& operator=(RAM&& other);
 
-        char Read(const sysbit_t address) const;
+        // Moves the pages to NUMA node `node` and keeps new ones there
+        bool Migrate(const int node) noexcept;
+
+        int Node() const noexcept
+        { return this->paging.node; }
+
+        // Reads don't log, an out of bounds access is reported through
+        // the returned error alone. Callers log if they need to.
+        Error Read(const sysbit_t address, char& value) const noexcept;
         Error Write(const sysbit_t address, char value) noexcept;
 
-        const Slice ReadSome(const sysbit_t address, const sysbit_t size) const;
+        // `data` points into RAM, valid until the next allocation change.
+        Error ReadSome(const sysbit_t address, const sysbit_t size, const char*& data) const noexcept;
         Error WriteSome(const sysbit_t address, const Slice values) noexcept;
 
-        sysbit_t Allocate(sysbit_t size);
+        // Range operations, each checks its whole range once and runs on
+        // the Bulk kernels. Copy's ranges may overlap, Swap's must not.
+        Error Copy(const sysbit_t to, const sysbit_t from, const sysbit_t size) noexcept;
+        Error Fill(const sysbit_t address, const Slice pattern, const sysbit_t count) noexcept;
+        Error Swap(const sysbit_t lhs, const sysbit_t rhs, const sysbit_t size) noexcept;
+
+        // No bounds check. Only for stack addresses InstructionStream::Verify
+        // has already proven, see CPU::RunBurst.
+        char* At(const sysbit_t address) noexcept
+        { return this->data.get()+address; }
+        const char* At(const sysbit_t address) const noexcept
+        { return this->data.get()+address; }
+
+        Error Allocate(sysbit_t size, sysbit_t& address) noexcept;
         Error Deallocate(const sysbit_t address, const sysbit_t size) noexcept;
 
+        // Whether [address, address+size) can be accessed
+        bool Contains(const sysbit_t address, const std::uint64_t size) const noexcept
+        { return this->Locate(address, size) != nullptr; }
+
         sysbit_t Size() const noexcept
         { return heapSize+stackSize; }
 
@@ -56,10 +107,50 @@ class RAM
         sysbit_t HeapSize() const noexcept
         { return heapSize; }
 
+        sysbit_t HeapLimit() const noexcept
+        { return heapLimit; }
+
+        // Heap cells in use and the longest run of free ones
+        sysbit_t HeapUsed() const noexcept
+        { return this->heap.Size()-this->heap.FreeCells(); }
+        sysbit_t LargestFree() const noexcept
+        { return this->heap.LargestRun(); }
+
     private:
-        std::unique_ptr<uchar_t[]> allocationMap;
-        std::unique_ptr<char[]> data;
+        struct Release
+        {
+            std::size_t size;
+            void operator()(char* data) const noexcept;
+        };
+
+        std::unique_ptr<char[], Release> data;
+        Heap heap;
         sysbit_t stackSize;
         sysbit_t heapSize;
+        sysbit_t heapLimit { 0 };
+        // bytes from the start that are backed, whole pages
+        std::size_t committed { 0 };
+        Paging paging { };
+        // charged for `committed`, nullptr for none
+        Budget* budget { nullptr };
+        Handles handles;
+        bool handled { false };
         const Board& board;
+
+        // Grows the heap so a run of `size` cells fits at its end
+        bool Grow(const sysbit_t size) noexcept;
+        bool Commit(const std::size_t end) noexcept;
+        // Slides every block down to the start of the heap, so the free
+        // cells are one run. Only with handles, false if it can't help
+        // a `size` cell block fit.
+        bool Compact(const sysbit_t size) noexcept;
+
+        // Where [address, address+size) is in `data`, nullptr when it's
+        // out of bounds. With handles a heap range must lie in one block.
+        char* Locate(const sysbit_t address, const std::uint64_t size) const noexcept;
+
+        bool InBounds(const sysbit_t address, const std::uint64_t size) const noexcept
+        { return address < this->Size() && size <= this->Size()-address; }
+
+        Error WriteError(const sysbit_t address) const noexcept;
 };
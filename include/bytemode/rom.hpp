@@ -30,7 +30,7 @@ class ROM
 
         char Read(sysbit_t index) const { return (*this)[index]; }
         Error TryRead(sysbit_t index, char& data, std::function<void()> failAct = { }) const noexcept;
-        const Slice ReadSome(const sysbit_t index, const sysbit_t size) const;
+        Error ReadSome(const sysbit_t index, const sysbit_t size, const char*& data) const noexcept;
 
     private:
         std::unique_ptr<char[]> data = nullptr;
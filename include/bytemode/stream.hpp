@@ -0,0 +1,93 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include "bytemode/instructions.hpp"
+#include "CSRConfig.hpp"
+#include "system.hpp"
+
+class ROM;
+class SysCallHandler;
+
+class InstructionStream
+{
+    public:
+        static constexpr sysbit_t npos { std::numeric_limits<sysbit_t>::max() };
+
+        // How many times each superinstruction replaced a sequence
+        struct FusionCounts
+        {
+            sysbit_t foldedConstants { 0 };
+            sysbit_t compareJumps { 0 };
+            sysbit_t sysCallPrologues { 0 };
+        };
+
+        InstructionStream(const ROM& rom) : rom(rom)
+        { }
+
+        InstructionStream(InstructionStream&) = delete;
+        void operator=(InstructionStream const&) = delete;
+        void operator=(InstructionStream const&&) = delete;
+
+        // Decodes the whole ROM body in a single linear sweep. The last
+        // instruction is a sentinel sitting at the end of the ROM.
+        Error Decode() noexcept;
+
+        // Decodes a single instruction at the given ROM address, used when
+        // execution lands somewhere the linear sweep didn't see as an
+        // instruction start.
+        void DecodeAt(sysbit_t pc, Instruction& out) const noexcept;
+
+        // Replaces common instruction sequences with fused superinstructions.
+        // Only the head of a sequence is replaced, the rest stay decoded so
+        // jumping into the middle of one still works.
+        void Fuse() noexcept;
+
+        const FusionCounts& Fusions() const noexcept
+        { return this->fusions; }
+
+        // What the verifier could prove about the stream
+        struct VerifyCounts
+        {
+            // instructions that may run without bounds checks
+            sysbit_t proven { 0 };
+            // static jumps that don't land on an instruction start
+            sysbit_t badTargets { 0 };
+        };
+
+        // Walks the stream backwards and works out, for every instruction,
+        // how much stack the straight-line run starting at it reads and
+        // pushes. CPU::RunBurst checks that once at the start of a run and
+        // then executes it without bounds checks, see --verified. Anything
+        // the verifier can't reason about keeps the checked path.
+        void Verify() noexcept;
+
+        const VerifyCounts& Verification() const noexcept
+        { return this->verification; }
+
+        // Gives every cal the syscall slot its operand would name, so a
+        // syscall doesn't look its id up every time it runs. Whether a cal
+        // is a syscall is only known when it runs, normal calls just never
+        // use theirs.
+        void Link(class SysCallHandler& syscalls);
+
+        // Decoded index of the instruction starting at ROM address pc,
+        // npos if there is none.
+        sysbit_t Locate(sysbit_t pc) const noexcept
+        { return pc < this->offsets.size() ? this->offsets[pc] : npos; }
+
+        const Instruction& operator[](sysbit_t index) const noexcept
+        { return this->instructions[index]; }
+
+        sysbit_t Size() const noexcept
+        { return static_cast<sysbit_t>(this->instructions.size()); }
+
+    private:
+        std::vector<Instruction> instructions;
+        // ROM address -> decoded index
+        std::vector<sysbit_t> offsets;
+        FusionCounts fusions;
+        VerifyCounts verification;
+        const ROM& rom;
+};
@@ -2,6 +2,7 @@
 
 #include <unordered_set>
 #include <unordered_map>
+#include <vector>
 #include <functional>
 
 #include "CSRConfig.hpp"
@@ -58,10 +59,29 @@ class SysCallHandler : public ISysCallHandler
         const char* const operator()(sysbit_t id, const char* const params) const noexcept
         { return (*this)[id](params); }
 
+        // Handler bound to the id, nullptr if there is none
+        SysFunctionHandler Find(sysbit_t id) const noexcept
+        {
+            const SysFunctionMap::const_iterator found { this->boundFuncs.find(id) };
+            return found == this->boundFuncs.end() ? nullptr : found->second;
+        }
+
+        // Slot for the id, created on first use. A slot holds whatever is
+        // bound to its id right now, binding and unbinding update it.
+        sysbit_t Slot(sysbit_t id);
+
+        // Handler in a slot without looking the id up, falls back to Find
+        // for call sites that never got one.
+        SysFunctionHandler Resolve(sysbit_t slot, sysbit_t id) const noexcept
+        { return slot < this->slots.size() ? this->slots[slot] : this->Find(id); }
+
         dlID_t LoadDl(std::string_view dlPath);
         sysfnh_t MakeFunctionHandler(dlID_t dl, std::string_view functionName) const;
 
     private:
         SysFunctionMap boundFuncs; 
         DLList dlList;
+
+        std::vector<SysFunctionHandler> slots;
+        std::unordered_map<sysbit_t, sysbit_t> slotIds;
 };
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <iostream>
+#include <string>
 
 #include "CLIParser.hpp"
 
@@ -10,3 +12,6 @@ void PrintHeader() noexcept;
 void PrintHelp(const CLIParser::Flags& flags) noexcept;
 
 CLIParser::Flags SetUpCLI(char** args, int argc);
+
+// Bytes in a size flag like 4096, 512K, 64M or 2G, crashes on anything else
+std::uint64_t ParseBytes(const std::string& flag, const std::string& text);
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <array>
 #include <bit>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <type_traits>
 
 #include "CSRConfig.hpp"
@@ -12,72 +15,117 @@ concept byte_t = requires(){
     std::is_same_v<T, uchar_t>;
 };
 
-template<std::integral T, byte_t U>
-T IntegerFromBytes(const U* bytes) noexcept
+// std::byteswap is C++23, the fallback folds to a single bswap
+template<std::integral T>
+constexpr T ByteSwap(const T value) noexcept
 {
-    if (std::endian::native == std::endian::big)
-        return *reinterpret_cast<T*>(const_cast<uchar_t*>(reinterpret_cast<const uchar_t*>(bytes)));
+#if defined(__cpp_lib_byteswap)
+    return std::byteswap(value);
+#else
+    std::make_unsigned_t<T> uvalue { static_cast<std::make_unsigned_t<T>>(value) };
+    std::make_unsigned_t<T> swapped { 0 };
 
-    // bytes must be in big endian order
-    std::make_unsigned_t<T> ures { 0 };
-
-    for (char i = 0; i < sizeof(T); i++)
+    for (std::size_t i = 0; i < sizeof(T); i++)
     {
-        ures <<= sizeof(uchar_t)*8;
-        ures |= static_cast<uchar_t>(bytes[i]);
+        swapped = (swapped << 8) | (uvalue & 0xFF);
+        uvalue >>= 8;
     }
 
-    return static_cast<T>(ures);
+    return static_cast<T>(swapped);
+#endif
 }
 
-template<byte_t T>
-float FloatFromBytes(const T* bytes) noexcept
+// Converts between host order and the big endian order RAM and ROM use,
+// the same operation both ways.
+template<std::integral T>
+constexpr T BigEndian(const T value) noexcept
 {
-    if (std::endian::native == std::endian::big)
-        return *reinterpret_cast<float*>(const_cast<uchar_t*>(reinterpret_cast<const uchar_t*>(bytes)));
+    if constexpr (std::endian::native == std::endian::big || sizeof(T) == 1)
+        return value;
+    else
+        return ByteSwap(value);
+}
 
-    float returnFloat { 0 };
-    uchar_t* tmpB { reinterpret_cast<uchar_t*>(&returnFloat) };
+// bytes must be in big endian order
+template<std::integral T, byte_t U>
+T IntegerFromBytes(const U* bytes) noexcept
+{
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return BigEndian(value);
+}
 
-    tmpB[0] = bytes[3];
-    tmpB[1] = bytes[2];
-    tmpB[2] = bytes[1];
-    tmpB[3] = bytes[0];
+template<byte_t T>
+float FloatFromBytes(const T* bytes) noexcept
+{ return std::bit_cast<float>(IntegerFromBytes<std::uint32_t>(bytes)); }
 
-    return returnFloat;
+// Writes sizeof(T) bytes in big endian order to `out`
+template<std::integral T, byte_t U>
+void IntegerToBytes(const T integer, U* out) noexcept
+{
+    const T value { BigEndian(integer) };
+    std::memcpy(out, &value, sizeof(T));
 }
 
-// Caller must free the bytes
+template<byte_t T>
+void FloatToBytes(const float val, T* out) noexcept
+{ IntegerToBytes(std::bit_cast<std::uint32_t>(val), out); }
+
+// Bytes in big endian order, held by value
 template<std::integral T, byte_t U = char>
-U* BytesFromInteger(const T integer) noexcept
+std::array<U, sizeof(T)> BytesFromInteger(const T integer) noexcept
 {
-    if (std::endian::native == std::endian::big)
-        return reinterpret_cast<U*>(new T{integer});
-
-    // bytes will be in big endian order
-    std::make_unsigned_t<T> uinteger { reinterpret_cast<std::make_unsigned_t<T>>(integer) };
-    uchar_t* bytes { new uchar_t[sizeof(uinteger)] };
-
-    for (char i = 0; i < sizeof(T); i++)
-        bytes[sizeof(uinteger)-1-i] = static_cast<uchar_t>((uinteger >> (i*8)));
-
-    return reinterpret_cast<U*>(bytes);
+    std::array<U, sizeof(T)> bytes;
+    IntegerToBytes(integer, bytes.data());
+    return bytes;
 }
 
-// Caller must free the bytes
 template<byte_t T = char>
-T* BytesFromFloat(const float val) noexcept
+std::array<T, sizeof(float)> BytesFromFloat(const float val) noexcept
 {
-    if (std::endian::native == std::endian::big)
-        return reinterpret_cast<T*>(new float{val});
+    std::array<T, sizeof(float)> bytes;
+    FloatToBytes(val, bytes.data());
+    return bytes;
+}
 
-    uchar_t* bytes { new uchar_t[4] };
-    const uchar_t* tmpB { reinterpret_cast<const uchar_t*>(&val) };
+// Board RAM holds multi-byte values big endian like ROM does, unless
+// built with NATIVE_ENDIAN_RAM which keeps them in host order. Anything
+// loading or storing a value in RAM goes through these.
+#ifdef NATIVE_ENDIAN_RAM
+    constexpr std::endian RamEndian { std::endian::native };
+#else
+    constexpr std::endian RamEndian { std::endian::big };
+#endif
+
+// Converts between host order and RAM order, the same operation both ways
+template<std::integral T>
+constexpr T RamOrder(const T value) noexcept
+{
+    if constexpr (RamEndian == std::endian::native || sizeof(T) == 1)
+        return value;
+    else
+        return ByteSwap(value);
+}
 
-    bytes[0] = tmpB[3];
-    bytes[1] = tmpB[2];
-    bytes[2] = tmpB[1];
-    bytes[3] = tmpB[0];
+template<std::integral T, byte_t U>
+T IntegerFromRam(const U* bytes) noexcept
+{
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return RamOrder(value);
+}
+
+template<byte_t T>
+float FloatFromRam(const T* bytes) noexcept
+{ return std::bit_cast<float>(IntegerFromRam<std::uint32_t>(bytes)); }
 
-    return reinterpret_cast<T*>(bytes);
+template<std::integral T, byte_t U>
+void IntegerToRam(const T integer, U* out) noexcept
+{
+    const T value { RamOrder(integer) };
+    std::memcpy(out, &value, sizeof(T));
 }
+
+template<byte_t T>
+void FloatToRam(const float val, T* out) noexcept
+{ IntegerToRam(std::bit_cast<std::uint32_t>(val), out); }
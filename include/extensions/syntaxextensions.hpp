@@ -9,6 +9,9 @@
 
 #define nameof(variable) #variable
 
+// Without exceptions (the bytemode library can be built with
+// -fno-exceptions) there is nothing to catch, only expr is kept.
+#if defined(__cpp_exceptions)
 #define try_catch(expr, catchcsr, catchother) \
     try { \
         expr \
@@ -21,6 +24,12 @@
         std::cerr << "An unexpected exception occured during process.\n\tProvided information: " << exc.what() << '\n'; \
         catchother  \
     }
+#else
+#define try_catch(expr, catchcsr, catchother) \
+    { \
+        expr \
+    }
+#endif
 
 
 using namespace std::string_view_literals;
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "bytemode/cpu.hpp"
+#include "bytemode/stream.hpp"
+#include "CSRConfig.hpp"
+#include "system.hpp"
+
+// Baseline JIT. Translates hot regions of an InstructionStream into x86-64,
+// one short template per instruction, keeping sp and the 32-bit general
+// registers in host registers. A region runs from the instruction it was
+// entered at along the fallthrough until the first instruction it can't
+// translate, jumps inside the region stay native. Anything else hands
+// control back to the interpreter at the instruction's pc.
+//
+// Stack bounds come from InstructionStream::Verify, a region checks sp
+// once at the start of each straight-line run like CPU::RunBurst does
+// with --verified.
+//
+// Boards of one assembly share its JIT, with --threads they heat and
+// enter regions from several workers at once. Counting stays a plain
+// load and store, a lost increment only delays promotion, and Promote
+// is serialised.
+class JIT
+{
+    public:
+        // Runs until execution leaves the region or the budget runs out,
+        // writes the registers back to `state` and returns the budget left.
+        using Region = std::int64_t (*)(CPU::State* state, char* ram, std::int64_t budget, sysbit_t stackSize);
+
+        JIT(const InstructionStream& stream, const std::string& name);
+        ~JIT();
+
+        JIT(JIT&) = delete;
+        void operator=(JIT const&) = delete;
+        void operator=(JIT const&&) = delete;
+
+        // Counts a call or back-edge landing on `index`. The region
+        // starting there is translated once it's been landed on often
+        // enough, cold code never is.
+        void Heat(sysbit_t index) noexcept
+        {
+            if (index >= this->heat.size())
+                return;
+
+            std::atomic_ref<std::uint32_t> count { this->heat[index] };
+            const std::uint32_t now { count.load(std::memory_order_relaxed) + 1 };
+            count.store(now, std::memory_order_relaxed);
+
+            if (now == this->threshold)
+                this->Promote(index);
+        }
+
+        // Native code for the region starting at the given instruction,
+        // nullptr unless it was promoted and could be translated.
+        Region Get(sysbit_t index) const noexcept
+        {
+            return index < this->regions.size()
+                ? this->regions[index].load(std::memory_order_acquire)
+                : nullptr;
+        }
+
+    private:
+        struct Block
+        {
+            void* code;
+            std::size_t size;
+        };
+
+        const InstructionStream& stream;
+        std::string name;
+
+        std::vector<std::atomic<Region>> regions;
+        std::vector<bool> tried;
+        std::vector<Block> blocks;
+        std::mutex promoting;
+
+        // calls and back-edges per instruction, see Heat
+        std::vector<std::uint32_t> heat;
+        std::uint32_t threshold;
+        bool report;
+
+        void Promote(sysbit_t index) noexcept;
+
+        // Whether `ins` has a template, `need` and `grow` are the stack
+        // effect of the ones the verifier doesn't summarise.
+        static bool Translatable(const Instruction& ins, sysbit_t& need, sysbit_t& grow) noexcept;
+
+        Region Compile(sysbit_t index) noexcept;
+        Region Install(const std::vector<uchar_t>& code, sysbit_t pc) noexcept;
+};
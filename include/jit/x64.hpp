@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include "CSRConfig.hpp"
+
+// A minimal x86-64 assembler, just the instructions the JIT templates use.
+// Operands are 32-bit unless the name says otherwise.
+class X64
+{
+    public:
+        enum Reg : uchar_t
+        {
+            rax, rcx, rdx, rbx, rsp, rbp, rsi, rdi,
+            r8, r9, r10, r11, r12, r13, r14, r15,
+            none = 0xFF
+        };
+
+        enum Cond : uchar_t
+        {
+            o, no, b, ae, e, ne, be, a,
+            s, ns, p, np, l, ge, le, g
+        };
+
+        // [base + index + disp]
+        struct Mem
+        {
+            Reg base;
+            Reg index { none };
+            std::int32_t disp { 0 };
+        };
+
+        // A rel32 waiting for its target
+        using Patch = std::size_t;
+
+        const std::vector<uchar_t>& Code() const noexcept
+        { return this->code; }
+
+        std::size_t Here() const noexcept
+        { return this->code.size(); }
+
+        void Push64(Reg reg);
+        void Pop64(Reg reg);
+        void Ret();
+
+        void Mov(Reg to, Reg from);
+        void Mov(Reg to, std::uint32_t imm);
+        void Load(Reg to, Mem from);
+        void Store(Mem to, Reg from);
+        void Store(Mem to, std::uint32_t imm);
+
+        void Load8(Reg to, Mem from);
+        void Store8(Mem to, Reg from);
+        void Store8(Mem to, uchar_t imm);
+        void Add8(Mem to, uchar_t imm);
+        void Cmp8(Mem lhs, uchar_t imm);
+
+        void Add(Reg to, Reg from);
+        void Sub(Reg to, Reg from);
+        void Imul(Reg to, Reg from);
+        void Cmp(Reg lhs, Reg rhs);
+        void And(Reg to, Reg from);
+        void Or(Reg to, Reg from);
+        void Add(Reg to, std::uint32_t imm);
+        void Sub(Reg to, std::uint32_t imm);
+        void Cmp(Reg lhs, std::uint32_t imm);
+        void And(Reg to, std::uint32_t imm);
+        void Lea(Reg to, Mem from);
+        void Bswap(Reg reg);
+        void Set(Cond cond, Reg to);
+
+        void Mov64(Reg to, Reg from);
+        void Sub64(Reg to, std::uint32_t imm);
+        void Test64(Reg lhs, Reg rhs);
+
+        Patch Jmp();
+        Patch J(Cond cond);
+        void Jmp(std::size_t target);
+        void J(Cond cond, std::size_t target);
+        void Bind(Patch patch, std::size_t target);
+
+    private:
+        std::vector<uchar_t> code;
+
+        void Byte(uchar_t value)
+        { this->code.push_back(value); }
+        void Dword(std::uint32_t value);
+
+        void Rex(bool wide, uchar_t reg, uchar_t index, uchar_t base, bool force = false);
+        void Operand(uchar_t reg, Mem mem);
+        void Operand(uchar_t reg, Reg rm);
+
+        void MemOp(bool wide, std::initializer_list<uchar_t> opcode, uchar_t reg, Mem mem, bool byteReg = false);
+        void RegOp(bool wide, std::initializer_list<uchar_t> opcode, uchar_t reg, Reg rm, bool byteReg = false);
+};
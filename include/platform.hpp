@@ -1,6 +1,7 @@
 #pragma once
 
 #include "system.hpp"
+#include <cstddef>
 #include <filesystem>
 #include <string_view>
 
@@ -11,6 +12,7 @@
     using sym_t = FARPROC
 #elif defined(unix) || defined(__unix) || defined(__unix__)
     #include <dlfcn.h>
+    #include <sys/mman.h>
     #include <unistd.h>
     #include <climits>
 
@@ -19,6 +21,8 @@
 #elif defined(__APPLE__) || defined(__MACH__)
     #include <dlfcn.h>
     #include <mach-o/dyld.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
     #include <climits>
 
     using dlID_t = void*;
@@ -31,6 +35,43 @@ dlID_t DLLoad(std::string_view path);
 bool DLUnload(dlID_t dlID);
 std::filesystem::path GetExePath();
 
+// Virtual memory. Reserve takes address space without backing it, Commit
+// makes pages of it usable. Sizes and offsets are in multiples of PageSize.
+std::size_t PageSize() noexcept;
+void* MemReserve(std::size_t size) noexcept;
+bool MemCommit(void* at, std::size_t size) noexcept;
+void MemRelease(void* at, std::size_t size) noexcept;
+// Faults committed pages in now rather than on first touch
+void MemPrefault(void* at, std::size_t size) noexcept;
+// Asks for transparent huge pages, only a hint and a no-op where unsupported
+void MemHugePages(void* at, std::size_t size) noexcept;
+
+// Copy-on-write images. MemSnapshot copies a range into an anonymous file,
+// MemMapSnapshot maps it privately over reserved pages so everything mapping
+// it shares its pages until they're written. Only on Linux, elsewhere the
+// snapshot is invalid and callers copy the memory instead.
+using memsnap_t = int;
+constexpr memsnap_t InvalidSnapshot { -1 };
+memsnap_t MemSnapshot(const void* at, std::size_t size) noexcept;
+bool MemMapSnapshot(memsnap_t snapshot, void* at, std::size_t size) noexcept;
+void MemDropSnapshot(memsnap_t snapshot) noexcept;
+
+// NUMA. NumaNodes counts the nodes, 1 without NUMA, and NumaNode is the
+// one the calling thread runs on. MemBindNode places the pages of a range
+// on `node` when it can, moving the ones already backed with `move`.
+// PinThreadToNode keeps the calling thread on the node's cpus. All of it
+// is Linux only, elsewhere there's a single node.
+int NumaNodes() noexcept;
+int NumaNode() noexcept;
+bool MemBindNode(void* at, std::size_t size, int node, bool move) noexcept;
+bool PinThreadToNode(int node) noexcept;
+
+// SIGUSR1 asks for a dump, see --profile. Watch installs the handler, a
+// no-op where there's no such signal, and DumpRequested says whether it
+// fired since it was last asked.
+void WatchDumpSignal() noexcept;
+bool DumpRequested() noexcept;
+
 template<typename T>
 T DLSym(dlID_t dlID, std::string_view name)
 {
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "CSRConfig.hpp"
+#include "system.hpp"
+
+class Board;
+
+// Runs boards on a pool of worker threads, see --threads. A round hands
+// each board to a worker as one task. Workers take tasks off the front of
+// their own deque and, once it's empty, steal off the back of the others,
+// the ones on their own NUMA node first. The calling thread is worker 0
+// and Run returns once every task is done, so whatever happens between
+// rounds (messages, adding and removing boards) stays on one thread.
+class Scheduler
+{
+    public:
+        // `numa` pins workers round-robin to the nodes and hands boards to
+        // the workers on their RAM's node
+        Scheduler(const sysbit_t threads, const bool numa);
+        ~Scheduler();
+
+        Scheduler(Scheduler&) = delete;
+        void operator=(Scheduler const&) = delete;
+        void operator=(Scheduler const&&) = delete;
+
+        // Runs each board for up to `slice` Board::Run calls
+        void Run(const std::vector<Board*>& boards, const sysbit_t slice) noexcept;
+
+        sysbit_t Threads() const noexcept
+        { return static_cast<sysbit_t>(this->workers.size()); }
+
+    private:
+        struct Worker
+        {
+            std::mutex lock;
+            std::deque<Board*> tasks;
+            int node;
+            std::thread thread;
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        bool numa;
+
+        // guards round and stopping
+        std::mutex lock;
+        std::condition_variable wake;
+        std::condition_variable finished;
+        std::uint64_t round { 0 };
+        bool stopping { false };
+
+        std::atomic<std::size_t> pending { 0 };
+        sysbit_t slice { 0 };
+
+        void Work(const std::size_t self) noexcept;
+        // Runs tasks until there are none left to take or steal
+        void Drain(const std::size_t self) noexcept;
+        Board* Take(const std::size_t self) noexcept;
+};
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 #include "CSRConfig.hpp"
+#include "budget.hpp"
 #include "bytemode/assembly.hpp"
 #include "message.hpp"
+#include "scheduler.hpp"
 #include "system.hpp"
 
 using AssemblyCollection = std::unordered_map<std::string, Assembly>;
@@ -19,6 +24,42 @@ class VM : IMessageObject
         {
             bool strictMessages;
             bool unsafe;
+            // max instructions a process runs before returning to its board
+            sysbit_t burst;
+            // instructions a process runs before its board moves on to the
+            // next one, see Process::SetQuantum
+            sysbit_t quantum;
+            bool stats;
+            // run code InstructionStream::Verify proved without bounds checks
+            bool verified;
+            // bytes each board's heap may grow to on demand, at or below
+            // the header's heap size keeps the heap fixed
+            sysbit_t maxHeap;
+            // fault board RAM in when it's created instead of on first touch
+            bool prefault;
+            // ask for transparent huge pages for board RAM
+            bool hugePages;
+            // worker threads running the boards, see Scheduler
+            sysbit_t threads;
+            // put each board's RAM on the NUMA node of the thread running it
+            bool numa;
+            // hand out heap blocks through handles so they can be compacted
+            bool handles;
+            // record what each board does with its memory, see Profile
+            bool profile;
+            // bytes a board, an assembly and the whole VM may hold, 0
+            // for no cap
+            std::uint64_t boardMemory;
+            std::uint64_t assemblyMemory;
+            std::uint64_t vmMemory;
+            // boards to clone off each executable's first board once its
+            // pc reaches cloneAt (the entry point if 0), 0 for none
+            sysbit_t clones;
+            sysbit_t cloneAt;
+#ifdef ENABLE_JIT
+            // calls/back-edges into code before the JIT translates it
+            sysbit_t hotness;
+#endif
 #ifndef NDEBUG
             bool step;
 #endif
@@ -51,14 +92,31 @@ class VM : IMessageObject
         inline const VMSettings& GetSettings() const noexcept
         { return this->settings; }
 
+        // What every assembly and board holds, see --vm-memory
+        Budget& Memory() noexcept
+        { return this->budget; }
+        const Budget& Memory() const noexcept
+        { return this->budget; }
+
+        // NUMA node a new board's RAM goes on with --numa. The calling
+        // thread's one, or the next node round-robin with --threads so the
+        // workers pinned there run it.
+        int BoardNode() noexcept;
+
         Error Setup(VMSettings settings) noexcept;
 
         Error Run() noexcept;
 
     private:
+        // outlives the assemblies, they give their bytes back to it
+        Budget budget;
         AssemblyCollection assemblies;
         AssemblyIDCollection asmIds;
         VMSettings settings;
+        // nullptr unless --threads asks for more than one
+        std::unique_ptr<Scheduler> scheduler;
+        std::vector<Board*> tasks;
+        int nextNode { 0 };
 
         VM() { }
 
@@ -4,9 +4,11 @@
 #include <fstream>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "bytemode/assembly.hpp"
 #include "CSRConfig.hpp"
@@ -17,14 +19,25 @@
 #include "system.hpp"
 #include "vm.hpp"
 
+#ifdef ENABLE_JIT
+    #include "jit/jit.hpp"
+#endif
+
 //
 // Assembly Implementation
 //
 Assembly::Assembly(Assembly::AssemblySettings&& settings) :
+    budget(&VM::GetVM().Memory(), VM::GetVM().GetSettings().assemblyMemory),
     settings(settings),
     syscallHandler()
 { }
 
+Assembly::~Assembly()
+{
+    // boards still running when the VM exits
+    this->DumpProfiles();
+}
+
 Error Assembly::Load() noexcept
 {
     if (!std::filesystem::exists(this->settings.path))
@@ -63,6 +76,16 @@ Error Assembly::Load() noexcept
     });
     bytecode.seekg(0, std::ios::beg);
 
+    if (!this->budget.Charge(static_cast<std::uint64_t>(length)))
+    {
+        bytecode.close();
+        LOGE(
+            System::LogLevel::Medium, this->Stringify(), " ROM of ", std::to_string(length),
+            " bytes doesn't fit in the assembly's or the VM's memory budget."
+        );
+        return System::ErrorCode::MemoryOverflow;
+    }
+
     std::unique_ptr<char[]> data { new char[length] };
     bytecode.read(data.get(), length);
     bytecode.close();
@@ -74,8 +97,57 @@ Error Assembly::Load() noexcept
     if (this->settings.type == AssemblyType::Library)
         return System::ErrorCode::Ok;
 
+    // Decode the whole ROM once, boards execute from the stream.
+    System::ErrorCode err { this->stream.Decode() };
+    if (err != System::ErrorCode::Ok)
+    {
+        LOGE(System::LogLevel::Medium, this->Stringify(), " ROM is too small to hold a header.");
+        return err;
+    }
+
+    const std::uint64_t decoded { std::uint64_t{this->stream.Size()}*sizeof(Instruction) };
+    if (!this->budget.Charge(decoded))
+    {
+        LOGE(
+            System::LogLevel::Medium, this->Stringify(), " decoded instructions of ", std::to_string(decoded),
+            " bytes don't fit in the assembly's or the VM's memory budget."
+        );
+        return System::ErrorCode::MemoryOverflow;
+    }
+
+    this->stream.Fuse();
+    this->stream.Verify();
+    this->stream.Link(this->syscallHandler);
+
+    const InstructionStream::VerifyCounts& verified { this->stream.Verification() };
+    if (VM::GetVM().GetSettings().verified && verified.badTargets != 0)
+        LOGW(
+            this->Stringify(), " has ", std::to_string(verified.badTargets),
+            " jumps that don't land on an instruction, they run checked."
+        );
+
+    if (VM::GetVM().GetSettings().stats)
+    {
+        const InstructionStream::FusionCounts& fused { this->stream.Fusions() };
+        LOG(
+            this->Stringify(), " fused instructions: ",
+            std::to_string(fused.foldedConstants), " folded constants, ",
+            std::to_string(fused.compareJumps), " compare/jumps, ",
+            std::to_string(fused.sysCallPrologues), " syscall prologues."
+        );
+        LOG(
+            this->Stringify(), " verified instructions: ",
+            std::to_string(verified.proven), " of ", std::to_string(this->stream.Size()-1), "."
+        );
+    }
+
+#ifdef ENABLE_JIT
+    // Regions are translated on first use, boards share them.
+    if (this->settings.jit)
+        this->jit = std::make_unique<JIT>(this->stream, this->settings.name);
+#endif
+
     // initialize the initial board.
-    System::ErrorCode err;
     try_catch(
         if (this->boards.size() == 0)
             err = this->AddBoard();,
@@ -111,10 +183,31 @@ sysbit_t Assembly::GenerateNewBoardID() const
     return id;
 }
 
+bool Assembly::BoardFits(const std::uint64_t bytes) const noexcept
+{
+    const std::uint64_t cap { VM::GetVM().GetSettings().boardMemory };
+    if ((cap == 0 || bytes <= cap) && this->budget.Fits(bytes))
+        return true;
+
+    LOGE(
+        System::LogLevel::Medium, "Can't add a board to ", this->Stringify(), ", its RAM of ",
+        std::to_string(bytes), " bytes doesn't fit in the memory budget."
+    );
+    return false;
+}
+
 Error Assembly::AddBoard() noexcept
 {
     if (this->boards.size() >= std::numeric_limits<sysbit_t>::max())
         return System::ErrorCode::Bad;
+
+    // the board checks its header itself
+    const char* sizes { nullptr };
+    if (
+        this->rom.ReadSome(4, 8, sizes) == System::ErrorCode::Ok
+        && !this->BoardFits(RAM::Footprint(IntegerFromBytes<sysbit_t>(sizes), IntegerFromBytes<sysbit_t>(sizes+4)))
+    )
+        return System::ErrorCode::MemoryOverflow;
     
     sysbit_t id { this->GenerateNewBoardID() };
     this->boards.emplace(
@@ -126,43 +219,58 @@ Error Assembly::AddBoard() noexcept
     return System::ErrorCode::Ok;
 }
 
+Error Assembly::CloneBoard(sysbit_t id, sysbit_t count) noexcept
+{
+    if (!this->boards.contains(id))
+        return System::ErrorCode::InvalidSpecifier;
+
+    // boards don't move when the collection grows
+    const Board& from { this->boards.at(id) };
+    const RAM::Image image { from.Snapshot() };
+
+    for (sysbit_t i = 0; i < count; i++)
+    {
+        if (this->boards.size() >= std::numeric_limits<sysbit_t>::max())
+            return System::ErrorCode::Bad;
+        // clones are charged for all of the RAM they share
+        if (!this->BoardFits(from.Memory().Used()))
+            return System::ErrorCode::MemoryOverflow;
+
+        const sysbit_t clone { this->GenerateNewBoardID() };
+        this->boards.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(clone),
+            std::forward_as_tuple(*this, clone, from, image)
+        );
+    }
+
+    return System::ErrorCode::Ok;
+}
+
 Error Assembly::RemoveBoard(sysbit_t id) noexcept
 {
     if (!this->boards.contains(id))
         return System::ErrorCode::InvalidSpecifier;
 
+    this->boards.at(id).DumpProfile();
     this->boards.erase(id);
 
     return System::ErrorCode::Ok;
 }
 
+void Assembly::DumpProfiles() const noexcept
+{
+    for (const auto& [id, board] : this->boards)
+        board.DumpProfile();
+}
+
 Error Assembly::Run() noexcept
 {
-    System::ErrorCode code { this->DispatchMessages() };
+    System::ErrorCode code { this->Settle() };
 
     if (code != System::ErrorCode::Ok)
         return code;
 
-    // Send Shutdown Signal to VM if the Assembly is not a runtime Library
-    if (this->boards.size() == 0 && this->settings.type != AssemblyType::Library)
-    {
-        std::unique_ptr<char[]> data { new char[5] };
-        char* id { BytesFromInteger<sysbit_t, char>(this->settings.id) };
-
-        std::memcpy(data.get(), id, sizeof(sysbit_t));
-        data[4] = 0;
-
-        delete[] id;
-
-        System::ErrorCode code { this->SendMessage({
-            MessageType::AtoV,
-            rval(data),
-        })};
-
-        if (code != System::ErrorCode::Ok)
-            CRASH(System::ErrorCode::MessageSendError, "Error, couldn't send shutdown signal to VM");
-    }
-
     for (auto& [id, board] : this->boards)
     {
         try_catch(
@@ -191,6 +299,42 @@ Error Assembly::Run() noexcept
     return code;
 }
 
+Error Assembly::Settle() noexcept
+{
+    System::ErrorCode code { this->DispatchMessages() };
+
+    if (code != System::ErrorCode::Ok)
+        return code;
+
+    // Send Shutdown Signal to VM if the Assembly is not a runtime Library
+    if (this->boards.size() == 0 && this->settings.type != AssemblyType::Library)
+    {
+        std::unique_ptr<char[]> data { new char[5] };
+        IntegerToBytes<sysbit_t>(this->settings.id, data.get());
+        data[4] = 0;
+
+        System::ErrorCode code { this->SendMessage({
+            MessageType::AtoV,
+            rval(data),
+        })};
+
+        if (code != System::ErrorCode::Ok)
+            CRASH(System::ErrorCode::MessageSendError, "Error, couldn't send shutdown signal to VM");
+    }
+
+    return code;
+}
+
+void Assembly::Schedule(std::vector<Board*>& tasks) noexcept
+{
+    for (auto& [id, board] : this->boards)
+    {
+        // cache the name here, workers only read it
+        board.Stringify();
+        tasks.push_back(&board);
+    }
+}
+
 //
 // IMessageObject Implementation
 //
@@ -203,11 +347,11 @@ Error Assembly::DispatchMessages() noexcept
 
         if (message.type() == MessageType::BtoA)
         {
+            sysbit_t id { IntegerFromBytes<sysbit_t>(message.data().get()) };
             if (message.data()[4] == 0)
-            {
-                sysbit_t id { IntegerFromBytes<sysbit_t>(message.data().get()) };
                 this->RemoveBoard(id);
-            }
+            else if (message.data()[4] == 1)
+                code = this->CloneBoard(id, VM::GetVM().GetSettings().clones);
         }
         else
             LOGE(
@@ -239,6 +383,9 @@ Error Assembly::ReceiveMessage(Message message) noexcept
     //      [targetId(4bytes), message...]
     // check the first 4bytes to verify the sender/target
 
+    // boards send from their workers, the pool is drained between rounds
+    std::lock_guard<std::mutex> guard { this->receiving };
+
     if (!VM::GetVM().GetSettings().strictMessages)
     {
         this->messagePool.push(message);
@@ -5,7 +5,6 @@
 #include <fstream>
 #include <ios>
 #include <iterator>
-#include <limits>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -25,27 +24,44 @@
 // Board Implementation
 //
 Board::Board(class Assembly& assembly, sysbit_t id) 
-    : assembly(assembly), cpu(*this), id(id)
+    : assembly(assembly), budget(&assembly.Memory(), VM::GetVM().GetSettings().boardMemory), cpu(*this), id(id)
 {
     // CPU will be initialized beforehand, so it checks the ROM.
      
+    const char* sizes { nullptr };
+    Error sizesErr { assembly.Rom().ReadSome(4, 8, sizes) };
+    if (sizesErr != System::ErrorCode::Ok)
+        CRASH(sizesErr, "In ", this->Stringify(), " ROM is too small to hold a header.");
+
     // second 32 bits of ROM is stack size
-    sysbit_t stackSize { IntegerFromBytes<sysbit_t>(assembly.Rom().ReadSome(4, 4).data)}; 
+    sysbit_t stackSize { IntegerFromBytes<sysbit_t>(sizes) }; 
 
     // third 32 bits of ROM is heap size
-    sysbit_t heapSize { IntegerFromBytes<sysbit_t>(assembly.Rom().ReadSome(8, 4).data)};
+    sysbit_t heapSize { IntegerFromBytes<sysbit_t>(sizes+4) };
     
-    // Create RAM
+    // Create RAM, the heap may grow past its header size with --max-heap
+    const VM::VMSettings& settings { VM::GetVM().GetSettings() };
     this->ram = {
         stackSize,
         heapSize,
+        settings.maxHeap,
+        {
+            .prefault = settings.prefault,
+            .hugePages = settings.hugePages,
+            .node = settings.numa ? VM::GetVM().BoardNode() : -1
+        },
+        settings.handles,
+        this->budget,
         *this
     };
 
+    if (settings.profile)
+        this->profile = std::make_unique<Profile>();
+
     // CPU is already created. 
 
     // Create the initial process
-    if (this->processes.size() == 0)
+    if (this->processes.Size() == 0)
     {
         System::ErrorCode code { this->AddProcess() };
 
@@ -58,53 +74,84 @@ Board::Board(class Assembly& assembly, sysbit_t id)
     }
 }
 
-uchar_t Board::GenerateNewProcessID() const
+Board::Board(class Assembly& assembly, sysbit_t id, const Board& from, const RAM::Image& image)
+    : currentProcess(from.currentProcess), forked(true), assembly(assembly),
+      budget(&assembly.Memory(), VM::GetVM().GetSettings().boardMemory), cpu(*this), id(id)
 {
-    uchar_t id { 0 };
-    for (; id <= std::numeric_limits<uchar_t>::max(); id++)
-        if (!this->processes.contains(id))
-            break;
-    return id;
+    this->ram = { image, this->budget, *this };
+
+    // same processes in the same turn order
+    uchar_t pid { from.currentProcess };
+    for (sysbit_t i = 0; i < from.processes.Size(); i++, pid = from.processes.Next(pid))
+    {
+        Process& process { this->processes.Emplace(pid, this->currentProcess, *this) };
+        process.LoadState(from.processes[pid].DumpState());
+        process.SetQuantum(from.processes[pid].Quantum());
+    }
+
+    // the executing process's state lives in the CPU
+    this->cpu.LoadState(from.cpu.DumpState());
+
+    // clones inherit the blocks they start with
+    if (from.profile != nullptr)
+        this->profile = std::make_unique<Profile>(*from.profile);
+}
+
+void Board::DumpProfile() const noexcept
+{
+    if (this->profile != nullptr)
+        this->profile->Dump(this->Stringify(), this->ram);
 }
 
 Error Board::ChangeExecutingProcess() noexcept
 {
     // Dump current state of CPU to currentProcess
-    this->processes.at(currentProcess).LoadState(this->cpu.DumpState());
+    this->processes[this->currentProcess].LoadState(this->cpu.DumpState());
 
-    // set the next process to be the current
-    this->currentProcess = std::min<uchar_t>(
-                                this->currentProcess, 
-                                this->processes.size()
-                            );
+    // Round-robin, the next one in the ring takes over
+    this->currentProcess = this->processes.Next(this->currentProcess);
 
     // Load the state from new state to CPU
-    this->cpu.LoadState(this->processes.at(currentProcess).DumpState());
+    this->cpu.LoadState(this->processes[this->currentProcess].DumpState());
 
     return System::ErrorCode::Ok;
 }
 
+void Board::Reschedule() noexcept
+{
+    const Request request { this->request };
+    const uchar_t id { this->currentProcess };
+    this->request = Request::None;
+
+    // nobody else to switch to
+    if (request == Request::Switch && this->processes.Next(id) == id)
+        return;
+
+    this->ChangeExecutingProcess();
+    if (request == Request::Exit)
+        this->RemoveProcess(id);
+}
+
 Error Board::AddProcess() noexcept
 {
-    if (this->processes.size() >= std::numeric_limits<uchar_t>::max())
+    const sysbit_t id { this->processes.FreeId() };
+    if (id == ProcessTable::Capacity)
         return System::ErrorCode::Bad;
 
-    uchar_t id { this->GenerateNewProcessID() };
-    this->processes.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(id),
-        std::forward_as_tuple(*this, id)
-    );
+    // the first process runs right away, the rest wait their turn
+    this->processes.Emplace(static_cast<uchar_t>(id), this->currentProcess, *this);
+    if (this->processes.Size() == 1)
+        this->currentProcess = static_cast<uchar_t>(id);
 
     return System::ErrorCode::Ok;
 }
 
 Error Board::RemoveProcess(uchar_t id) noexcept
 {
-    if (!this->processes.contains(id))
+    if (!this->processes.Contains(id))
         return System::ErrorCode::InvalidSpecifier;
 
-    this->processes.erase(id);
+    this->processes.Erase(id);
 
     return System::ErrorCode::Ok;
 }
@@ -118,16 +165,12 @@ Error Board::Run() noexcept
         return code;
 
     // Send Shutdown Signal to Assembly
-    if (this->processes.size() == 0)
+    if (this->processes.Size() == 0)
     {
         std::unique_ptr<char[]> data { new char[5] };
-        char* id { BytesFromInteger<sysbit_t, char>(this->id) };
-
-        std::memcpy(data.get(), id, sizeof(sysbit_t));
+        IntegerToBytes<sysbit_t>(this->id, data.get());
         data[4] = 0;
 
-        delete[] id;
-
         System::ErrorCode code { this->SendMessage({
             MessageType::BtoA,
             rval(data),
@@ -143,7 +186,31 @@ Error Board::Run() noexcept
         return code;
     }
 
-    code = this->processes.at(this->currentProcess).Cycle();
+    // The first board stops where --clone-at says and has the assembly
+    // clone it before it goes on
+    const VM::VMSettings& settings { VM::GetVM().GetSettings() };
+    if (settings.clones != 0 && !this->forked && this->id == 0 && this->cpu.DumpState().pc == (
+        settings.cloneAt != 0 ? settings.cloneAt : IntegerFromBytes<sysbit_t>(&this->assembly.Rom())
+    ))
+    {
+        this->forked = true;
+
+        std::unique_ptr<char[]> data { new char[5] };
+        IntegerToBytes<sysbit_t>(this->id, data.get());
+        data[4] = 1;
+
+        return this->SendMessage({
+            MessageType::BtoA,
+            rval(data),
+        });
+    }
+
+    code = this->processes[this->currentProcess].Cycle();
+    if (this->profile != nullptr)
+        this->profile->Stack(this->cpu.DumpState().sp);
+
+    if (this->request != Request::None)
+        this->Reschedule();
 
 //    if (code != System::ErrorCode::Ok)
 //        LOGE(
@@ -156,6 +223,17 @@ Error Board::Run() noexcept
     return code;
 }
 
+Error Board::Run(const sysbit_t times) noexcept
+{
+    System::ErrorCode code { System::ErrorCode::Ok };
+    this->signalled = false;
+
+    for (sysbit_t i = 0; i < times && code == System::ErrorCode::Ok && !this->signalled; i++)
+        code = this->Run();
+
+    return code;
+}
+
 const std::string& Board::Stringify() const noexcept
 {
     if (reprStr.size() != 0)
@@ -179,28 +257,14 @@ Error Board::DispatchMessages() noexcept
     {
         const Message& message { this->messagePool.front() };
 
-        if (message.type() == MessageType::PtoB)
-        {
-            // Process Interrupt, set currentProcess to next
-            if (message.data()[1] == 0)
-            {
-                if (static_cast<uchar_t>(message.data()[0]) != currentProcess) 
-                    return System::ErrorCode::InvalidSpecifier;
-                code = this->ChangeExecutingProcess();
-                if (code != System::ErrorCode::Ok)
-                    LOGE(System::LogLevel::Medium, this->Stringify(), " error while dispatching messages ", System::ErrorCodeString(code));
-            }
-
-            // Process requests Shutdown
-            else if (message.data()[1] == 1)
-            {
-                if (this->currentProcess == message.data()[0])
-                    this->ChangeExecutingProcess(); 
-                code = this->RemoveProcess(message.data()[0]);
-                if (code != System::ErrorCode::Ok)
-                    LOGE(System::LogLevel::Medium, this->Stringify(), " error while dispatching messages ", System::ErrorCodeString(code));
-            }
-        }
+        // Processes ask for switches and exits through Reschedule,
+        // nothing else is meant for the board itself yet
+        LOGE(
+            System::LogLevel::Low, 
+            "Unhandled message, type: ",
+            MessageTypeString(message.type())
+        );
+        code = System::ErrorCode::MessageDispatchError;
 
         this->messagePool.pop();
     }
@@ -229,7 +293,7 @@ Error Board::ReceiveMessage(Message message) noexcept
         case MessageType::PtoP:
         // [targetId(1byte), senderID(1byte), message...]
         {
-            if (!this->processes.contains(message.data()[0]) || !this->processes.contains(message.data()[1]))
+            if (!this->processes.Contains(static_cast<uchar_t>(message.data()[0])) || !this->processes.Contains(static_cast<uchar_t>(message.data()[1])))
                 return System::ErrorCode::Bad;
         }
         break;
@@ -237,7 +301,7 @@ Error Board::ReceiveMessage(Message message) noexcept
         case MessageType::PtoB:
         // [senderID(1byte), message...]
         {
-            if (!this->processes.contains(message.data()[0]))  
+            if (!this->processes.Contains(static_cast<uchar_t>(message.data()[0])))  
                 return System::ErrorCode::Bad;
         }
         break;
@@ -245,7 +309,7 @@ Error Board::ReceiveMessage(Message message) noexcept
         case MessageType::AtoB:
             // [targetId(4byte), message...]
             {
-                if (!this->processes.contains(IntegerFromBytes<sysbit_t>(message.data().get())))
+                if (!this->processes.Contains(IntegerFromBytes<sysbit_t>(message.data().get())))
                     return System::ErrorCode::Bad;
             }
             break;
@@ -275,11 +339,12 @@ Error Board::SendMessage(Message message) noexcept
         case MessageType::BtoP:
         // [targetId(1byte), message...]
         {
-            sysbit_t id { IntegerFromBytes<uchar_t>(message.data().get()) };
-            if (check && !this->processes.contains(id))
+            uchar_t id { IntegerFromBytes<uchar_t>(message.data().get()) };
+            // an empty slot has nothing to deliver to, checked or not
+            if (!this->processes.Contains(id))
                 return System::ErrorCode::Bad;
 
-            this->processes.at(id).ReceiveMessage(message);
+            this->processes[id].ReceiveMessage(message);
         }
         break;
 
@@ -289,6 +354,7 @@ Error Board::SendMessage(Message message) noexcept
             if (check && IntegerFromBytes<sysbit_t>(message.data().get()+4) != this->id)
                 return System::ErrorCode::Bad;
 
+            this->signalled = true;
             this->assembly.ReceiveMessage(message);
         }
         break;
@@ -296,9 +362,10 @@ Error Board::SendMessage(Message message) noexcept
         case MessageType::BtoA:
         // [senderId(4byte), message...]
         {
-            if (check && IntegerFromBytes<sysbit_t>(message.data().get())) 
+            if (check && IntegerFromBytes<sysbit_t>(message.data().get()) != this->id)
                 return System::ErrorCode::Bad;
 
+            this->signalled = true;
             this->assembly.ReceiveMessage(message);
         }
         break;
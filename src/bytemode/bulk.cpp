@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "bytemode/bulk.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define BULK_X86
+    #include <immintrin.h>
+#endif
+
+//
+// Kernels
+//
+namespace
+{
+    // Fill with a 4 byte pattern, `word` holds the pattern bytes as laid out in memory
+    using FillKernel = void (*)(char* to, std::uint32_t word, std::size_t count) noexcept;
+    using SwapKernel = void (*)(char* lhs, char* rhs, std::size_t size) noexcept;
+
+    struct KernelSet
+    {
+        FillKernel fill;
+        SwapKernel swap;
+    };
+
+    void FillTail(char* to, char* const end, const std::uint32_t word) noexcept
+    {
+        for (; to != end; to += 4)
+            std::memcpy(to, &word, 4);
+    }
+
+    void FillScalar(char* to, std::uint32_t word, std::size_t count) noexcept
+    { FillTail(to, to+count*4, word); }
+
+    void SwapScalar(char* lhs, char* rhs, std::size_t size) noexcept
+    { std::swap_ranges(lhs, lhs+size, rhs); }
+
+#ifdef BULK_X86
+    __attribute__((target("sse2")))
+    void FillSSE2(char* to, std::uint32_t word, std::size_t count) noexcept
+    {
+        const __m128i pattern { _mm_set1_epi32(static_cast<int>(word)) };
+        char* const end { to+count*4 };
+        for (; end-to >= 16; to += 16)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(to), pattern);
+        FillTail(to, end, word);
+    }
+
+    __attribute__((target("sse2")))
+    void SwapSSE2(char* lhs, char* rhs, std::size_t size) noexcept
+    {
+        for (; size >= 16; size -= 16, lhs += 16, rhs += 16)
+        {
+            const __m128i left { _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs)) };
+            const __m128i right { _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs)) };
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lhs), right);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(rhs), left);
+        }
+        SwapScalar(lhs, rhs, size);
+    }
+
+    __attribute__((target("avx2")))
+    void FillAVX2(char* to, std::uint32_t word, std::size_t count) noexcept
+    {
+        const __m256i pattern { _mm256_set1_epi32(static_cast<int>(word)) };
+        char* const end { to+count*4 };
+        for (; end-to >= 32; to += 32)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(to), pattern);
+        FillTail(to, end, word);
+    }
+
+    __attribute__((target("avx2")))
+    void SwapAVX2(char* lhs, char* rhs, std::size_t size) noexcept
+    {
+        for (; size >= 32; size -= 32, lhs += 32, rhs += 32)
+        {
+            const __m256i left { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs)) };
+            const __m256i right { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs)) };
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(lhs), right);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(rhs), left);
+        }
+        SwapSSE2(lhs, rhs, size);
+    }
+
+    __attribute__((target("avx512f")))
+    void FillAVX512(char* to, std::uint32_t word, std::size_t count) noexcept
+    {
+        const __m512i pattern { _mm512_set1_epi32(static_cast<int>(word)) };
+        char* const end { to+count*4 };
+        for (; end-to >= 64; to += 64)
+            _mm512_storeu_si512(to, pattern);
+        FillTail(to, end, word);
+    }
+
+    __attribute__((target("avx512f")))
+    void SwapAVX512(char* lhs, char* rhs, std::size_t size) noexcept
+    {
+        for (; size >= 64; size -= 64, lhs += 64, rhs += 64)
+        {
+            const __m512i left { _mm512_loadu_si512(lhs) };
+            const __m512i right { _mm512_loadu_si512(rhs) };
+            _mm512_storeu_si512(lhs, right);
+            _mm512_storeu_si512(rhs, left);
+        }
+        SwapSSE2(lhs, rhs, size);
+    }
+#endif
+
+    KernelSet Select() noexcept
+    {
+#ifdef BULK_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return { FillAVX512, SwapAVX512 };
+        if (__builtin_cpu_supports("avx2"))
+            return { FillAVX2, SwapAVX2 };
+        if (__builtin_cpu_supports("sse2"))
+            return { FillSSE2, SwapSSE2 };
+#endif
+        return { FillScalar, SwapScalar };
+    }
+
+    const KernelSet& Active() noexcept
+    {
+        static const KernelSet kernels { Select() };
+        return kernels;
+    }
+}
+
+//
+// Bulk Implementation
+//
+void Bulk::Copy(char* to, const char* from, std::size_t size) noexcept
+{
+    // libc already vectorizes memmove and memset, and picks its own
+    // kernels at load
+    std::memmove(to, from, size);
+}
+
+void Bulk::Fill(char* to, const char* pattern, std::size_t patternSize, std::size_t count) noexcept
+{
+    if (count == 0 || patternSize == 0)
+        return;
+
+    if (patternSize == 1)
+    {
+        std::memset(to, pattern[0], count);
+        return;
+    }
+
+    if (patternSize == 4)
+    {
+        std::uint32_t word;
+        std::memcpy(&word, pattern, 4);
+        Active().fill(to, word, count);
+        return;
+    }
+
+    // Anything else doubles what's already written until it's done
+    const std::size_t total { patternSize*count };
+    std::memcpy(to, pattern, patternSize);
+    for (std::size_t done = patternSize; done < total; )
+    {
+        const std::size_t chunk { std::min(done, total-done) };
+        std::memcpy(to+done, to, chunk);
+        done += chunk;
+    }
+}
+
+void Bulk::Swap(char* lhs, char* rhs, std::size_t size) noexcept
+{
+    Active().swap(lhs, rhs, size);
+}
+
+void Bulk::Zero(char* to, std::size_t size) noexcept
+{
+    std::memset(to, 0, size);
+}
@@ -1,4 +1,6 @@
 #include <cassert>
+#include <cstring>
+#include <iterator>
 #include <string>
 
 #include "bytemode/instructions.hpp"
@@ -7,8 +9,13 @@
 #include "bytemode/cpu.hpp"
 #include "CSRConfig.hpp"
 #include "system.hpp"
+#include "vm.hpp"
 
-CPU::CPU(Board& board) : board(board), state()
+#ifdef ENABLE_JIT
+    #include "jit/jit.hpp"
+#endif
+
+CPU::CPU(Board& board) : board(board), state(), stream(board.Assembly().Stream())
 {
     // Check ROM for stack/heap sizes beforehand.
     char tmp;
@@ -21,110 +28,396 @@ CPU::CPU(Board& board) : board(board), state()
     }
 
     this->state.pc = IntegerFromBytes<sysbit_t>(&board.Assembly().Rom());
+    this->ip = this->stream.Locate(this->state.pc);
+    this->verified = VM::GetVM().GetSettings().verified;
+#ifdef ENABLE_JIT
+    this->jit = board.Assembly().Jit();
+#endif
+}
+
+const OperationFunction CPU::operations[] {
+    NoOperation,
+    StoreThirtyTwo, StoreEight, StoreFromSymbol, StoreFromSymbol,
+    LoadFromStack, LoadFromStack, ReadFromHeap, ReadFromHeap, ReadFromRegister,
+    Move, Move, Move,
+    Add32, AddFloat, Add8, AddReg, AddReg, AddReg,
+    AddSafe32, AddSafeFloat, AddSafe8,
+    MemCopy,
+    Increment, Increment, Increment, IncrementReg, IncrementReg, IncrementReg,
+    IncrementSafe, IncrementSafe, IncrementSafe,
+    Decrement, Decrement, Decrement, DecrementReg, DecrementReg, DecrementReg,
+    DecrementSafe, DecrementSafe, DecrementSafe,
+    BitAnd, BitAnd, BitAnd,
+    BitOr, BitOr, BitOr,
+    BitNor, BitNor, BitNor,
+    SwapTop, SwapTop, SwapTop,
+    DuplicateTop, DuplicateTop,
+    RawDataStack, RawDataStack,
+    Invert, Invert, Invert, InvertSafe, InvertSafe,
+    Compare, Compare,
+    PopInstruction, PopInstruction,
+    Jump, Jump,
+    SwapRange, DuplicateRange,
+    Repeat,
+    Allocate,
+    PowRegister, PowRegister, PowRegister,
+    PowStack, PowStack, PowStack,
+    PowConst, PowConst, PowConst,
+    SqrtConst, SqrtConst, SqrtConst,
+    SqrtRegister, SqrtRegister, SqrtRegister,
+    SqrtStack, SqrtStack, SqrtStack,
+    ConditionalJump, ConditionalJump,
+    CallFunc, CallFunc,
+    MulStack, MulStack, MulStack,
+    MulRegister, MulRegister, MulRegister,
+    MulSafe, MulSafe, MulSafe,
+    DivStack, DivStack, DivStack,
+    DivRegister, DivRegister, DivRegister,
+    DivSafe, DivSafe, DivSafe,
+    Return,
+    Deallocate,
+    Sub32, SubFloat, Sub8, SubReg, SubReg, SubReg,
+    SubSafe32, SubSafeFloat, SubSafe8
+};
+
+void CPU::LoadState(const State& loadFrom) noexcept
+{
+    this->state = loadFrom;
+    this->ip = this->stream.Locate(this->state.pc);
+}
+
+const Instruction& CPU::Fetch() noexcept
+{
+    if (this->ip != InstructionStream::npos)
+        return this->stream[this->ip];
+
+    // pc isn't at an instruction start the decoder has seen, decode in place.
+    if (this->scratch.pc != this->state.pc || this->scratch.handler == nullptr)
+        this->stream.DecodeAt(this->state.pc, this->scratch);
+    return this->scratch;
 }
 
 Error CPU::Cycle() noexcept
 {
-    static constexpr OperationFunction ops[] = {
-        NoOperation,
-        StoreThirtyTwo, StoreEight, StoreFromSymbol, StoreFromSymbol,
-        LoadFromStack, LoadFromStack, ReadFromHeap, ReadFromHeap, ReadFromRegister,
-        Move, Move, Move,
-        Add32, AddFloat, Add8, AddReg, AddReg, AddReg,
-        AddSafe32, AddSafeFloat, AddSafe8,
-        MemCopy,
-        Increment, Increment, Increment, IncrementReg, IncrementReg, IncrementReg,
-        IncrementSafe, IncrementSafe, IncrementSafe,
-        Decrement, Decrement, Decrement, DecrementReg, DecrementReg, DecrementReg,
-        DecrementSafe, DecrementSafe, DecrementSafe,
-        BitAnd, BitAnd, BitAnd,
-        BitOr, BitOr, BitOr,
-        BitNor, BitNor, BitNor,
-        SwapTop, SwapTop, SwapTop,
-        DuplicateTop, DuplicateTop,
-        RawDataStack, RawDataStack,
-        Invert, Invert, Invert, InvertSafe, InvertSafe,
-        Compare, Compare,
-        PopInstruction, PopInstruction,
-        Jump, Jump,
-        SwapRange, DuplicateRange,
-        Repeat,
-        Allocate,
-        PowRegister, PowRegister, PowRegister,
-        PowStack, PowStack, PowStack,
-        PowConst, PowConst, PowConst,
-        SqrtConst, SqrtConst, SqrtConst,
-        SqrtRegister, SqrtRegister, SqrtRegister,
-        SqrtStack, SqrtStack, SqrtStack,
-        ConditionalJump, ConditionalJump,
-        CallFunc, CallFunc,
-        MulStack, MulStack, MulStack,
-        MulRegister, MulRegister, MulRegister,
-        MulSafe, MulSafe, MulSafe,
-        DivStack, DivStack, DivStack,
-        DivRegister, DivRegister, DivRegister,
-        DivSafe, DivSafe, DivSafe,
-        Return,
-        Deallocate,
-        Sub32, SubFloat, Sub8, SubReg, SubReg, SubReg,
-        SubSafe32, SubSafeFloat, SubSafe8
-    };
+    const Instruction& ins { this->Fetch() };
 
-    char op;
-    System::ErrorCode code { this->board.Assembly().Rom().TryRead(this->state.pc, op) };
+    this->state.pc = ins.next;
+    this->ip = ins.follow;
 
-    if (code != System::ErrorCode::Ok)
-    {
-        LOGE(
-            System::LogLevel::Medium, 
-            "In ", this->board.Stringify(),
-            ", error while trying to read the instructions from ROM. Exit code: ",
-            System::ErrorCodeString(code)
-        );
+    System::ErrorCode code { ins.handler(*this, ins) };
+    this->Resync();
+
+    if (code == System::ErrorCode::Ok)
         return code;
+
+    return this->Failed(ins, code);
+}
+
+Error CPU::RunBurst(sysbit_t& budget) noexcept
+{
+    // Calls, returns and faults go through the usual single step.
+    if (this->Fetch().dispatch == Instruction::Yield || budget <= 1)
+    {
+        budget -= budget != 0;
+        return this->Cycle();
+    }
+
+#ifdef ENABLE_JIT
+    // Promoted code runs native. The interpreter hands back whenever a jump
+    // lands on it, the two take turns until the budget runs out.
+    while (this->jit != nullptr)
+    {
+        if (JIT::Region region { this->jit->Get(this->ip) })
+        {
+            const std::int64_t left { region(
+                &this->state,
+                this->board.ram.At(0),
+                budget,
+                this->board.ram.StackSize()
+            )};
+            this->Resync();
+
+            budget = static_cast<sysbit_t>(left > 0 ? left : 0);
+            if (left <= 1 || this->Fetch().dispatch == Instruction::Yield)
+                return System::ErrorCode::Ok;
+        }
+
+        const Error code { this->Interpret(budget) };
+        if (code != System::ErrorCode::Ok || budget <= 1 || this->Fetch().dispatch == Instruction::Yield)
+            return code;
     }
+#endif
+
+    return this->Interpret(budget);
+}
+
+Error CPU::Interpret(sysbit_t& budget) noexcept
+{
+#ifdef THREADED_DISPATCH
+    if (this->verified && this->Fits(this->Fetch()))
+        return this->Burst<false>(budget);
+#endif
+    return this->Burst<true>(budget);
+}
+
+bool CPU::Fits(const Instruction& ins) const noexcept
+{
+    const sysbit_t stackSize { this->board.ram.StackSize() };
+    return this->state.sp >= ins.stackNeed
+        && ins.stackGrow <= stackSize
+        && this->state.sp <= stackSize - ins.stackGrow;
+}
+
+// Safe = false runs the unchecked stack handlers. The stack is checked
+// against InstructionStream::Verify's summary once whenever a run starts,
+// falling back to the checked handlers if it doesn't fit. The plain loop
+// always runs checked.
+template<bool Safe>
+Error CPU::Burst(sysbit_t& budget) noexcept
+{
+    const Instruction* ins { &this->Fetch() };
+    System::ErrorCode code { System::ErrorCode::Ok };
+
+#ifdef THREADED_DISPATCH
+    // Each opcode gets its own copy of the fetch-and-jump sequence, so the
+    // indirect branch at the end of an instruction is predicted based on
+    // that instruction alone. Jump tables mirror CPU::operations.
+#define Label(name) &&L_##name
+    static void* const labels[] {
+        Label(NoOperation),
+        Label(StoreThirtyTwo), Label(StoreEight), Label(StoreFromSymbol), Label(StoreFromSymbol),
+        Label(LoadFromStack), Label(LoadFromStack), Label(ReadFromHeap), Label(ReadFromHeap), Label(ReadFromRegister),
+        Label(Move), Label(Move), Label(Move),
+        Label(Add32), Label(AddFloat), Label(Add8), Label(AddReg), Label(AddReg), Label(AddReg),
+        Label(AddSafe32), Label(AddSafeFloat), Label(AddSafe8),
+        Label(MemCopy),
+        Label(Increment), Label(Increment), Label(Increment), Label(IncrementReg), Label(IncrementReg), Label(IncrementReg),
+        Label(IncrementSafe), Label(IncrementSafe), Label(IncrementSafe),
+        Label(Decrement), Label(Decrement), Label(Decrement), Label(DecrementReg), Label(DecrementReg), Label(DecrementReg),
+        Label(DecrementSafe), Label(DecrementSafe), Label(DecrementSafe),
+        Label(BitAnd), Label(BitAnd), Label(BitAnd),
+        Label(BitOr), Label(BitOr), Label(BitOr),
+        Label(BitNor), Label(BitNor), Label(BitNor),
+        Label(SwapTop), Label(SwapTop), Label(SwapTop),
+        Label(DuplicateTop), Label(DuplicateTop),
+        Label(RawDataStack), Label(RawDataStack),
+        Label(Invert), Label(Invert), Label(Invert), Label(InvertSafe), Label(InvertSafe),
+        Label(Compare), Label(Compare),
+        Label(PopInstruction), Label(PopInstruction),
+        Label(Jump), Label(Jump),
+        Label(SwapRange), Label(DuplicateRange),
+        Label(Repeat),
+        Label(Allocate),
+        Label(PowRegister), Label(PowRegister), Label(PowRegister),
+        Label(PowStack), Label(PowStack), Label(PowStack),
+        Label(PowConst), Label(PowConst), Label(PowConst),
+        Label(SqrtConst), Label(SqrtConst), Label(SqrtConst),
+        Label(SqrtRegister), Label(SqrtRegister), Label(SqrtRegister),
+        Label(SqrtStack), Label(SqrtStack), Label(SqrtStack),
+        Label(ConditionalJump), Label(ConditionalJump),
+        Label(Yield), Label(Yield),
+        Label(MulStack), Label(MulStack), Label(MulStack),
+        Label(MulRegister), Label(MulRegister), Label(MulRegister),
+        Label(MulSafe), Label(MulSafe), Label(MulSafe),
+        Label(DivStack), Label(DivStack), Label(DivStack),
+        Label(DivRegister), Label(DivRegister), Label(DivRegister),
+        Label(DivSafe), Label(DivSafe), Label(DivSafe),
+        Label(Yield),
+        Label(Deallocate),
+        Label(Sub32), Label(SubFloat), Label(Sub8), Label(SubReg), Label(SubReg), Label(SubReg),
+        Label(SubSafe32), Label(SubSafeFloat), Label(SubSafe8),
+
+        // Instruction::Generic, Instruction::Yield
+        Label(Generic), Label(Yield)
+    };
+#undef Label
+
+    static_assert(std::size(labels) == Instruction::Yield+1);
+
+    // A chained instruction was proven together with the one after it,
+    // anything else starts a new run.
+#define Dispatch() \
+        if (--budget == 0) \
+            return System::ErrorCode::Ok; \
+        if constexpr (!Safe) \
+        { \
+            if (!ins->chained && !this->Fits(this->Fetch())) \
+                return this->Burst<true>(budget); \
+        } \
+        ins = &this->Fetch(); \
+        goto *labels[ins->dispatch];
+
+    // Jumps that land on code the JIT has promoted hand the rest of the
+    // budget back to RunBurst.
+#ifdef ENABLE_JIT
+#define Promoted() \
+        if (this->jit != nullptr && this->jit->Get(this->ip) != nullptr) \
+        { \
+            --budget; \
+            return System::ErrorCode::Ok; \
+        }
+#else
+#define Promoted()
+#endif
 
-    if (sizeof(ops)/8 > op)
+#define Execute(name) \
+    L_##name: \
+        this->state.pc = ins->next; \
+        this->ip = ins->follow; \
+        code = name(*this, *ins); \
+        if (code != System::ErrorCode::Ok) \
+            return this->Failed(*ins, code); \
+        Dispatch()
+
+#define ExecuteStack(name) \
+    L_##name: \
+        this->state.pc = ins->next; \
+        this->ip = ins->follow; \
+        code = name<Safe>(*this, *ins); \
+        if (code != System::ErrorCode::Ok) \
+            return this->Failed(*ins, code); \
+        Dispatch()
+
+#define ExecuteJump(name) \
+    L_##name: \
+        this->state.pc = ins->next; \
+        this->ip = ins->follow; \
+        code = name<Safe>(*this, *ins); \
+        this->Resync(); \
+        if (code != System::ErrorCode::Ok) \
+            return this->Failed(*ins, code); \
+        Promoted() \
+        Dispatch()
+
+    goto *labels[ins->dispatch];
+
+    Execute(NoOperation)
+    ExecuteStack(StoreThirtyTwo) ExecuteStack(StoreEight) ExecuteStack(StoreFromSymbol)
+    ExecuteStack(LoadFromStack)
+    Execute(ReadFromHeap) Execute(ReadFromRegister)
+    Execute(Move)
+    ExecuteStack(Add32) ExecuteStack(AddFloat) ExecuteStack(Add8)
+    Execute(AddReg)
+    ExecuteStack(AddSafe32) ExecuteStack(AddSafeFloat) ExecuteStack(AddSafe8)
+    Execute(MemCopy)
+    ExecuteStack(Increment) Execute(IncrementReg) ExecuteStack(IncrementSafe)
+    ExecuteStack(Decrement) Execute(DecrementReg) ExecuteStack(DecrementSafe)
+    Execute(BitAnd) Execute(BitOr) Execute(BitNor)
+    ExecuteStack(SwapTop)
+    ExecuteStack(DuplicateTop)
+    ExecuteStack(RawDataStack)
+    ExecuteStack(Invert) ExecuteStack(InvertSafe)
+    ExecuteStack(Compare)
+    ExecuteStack(PopInstruction)
+    ExecuteJump(Jump)
+    Execute(SwapRange) Execute(DuplicateRange)
+    Execute(Repeat)
+    Execute(Allocate)
+    Execute(PowRegister) ExecuteStack(PowStack) ExecuteStack(PowConst)
+    Execute(SqrtRegister) ExecuteStack(SqrtStack) ExecuteStack(SqrtConst)
+    ExecuteJump(ConditionalJump)
+    ExecuteStack(MulStack) Execute(MulRegister) ExecuteStack(MulSafe)
+    ExecuteStack(DivStack) Execute(DivRegister) ExecuteStack(DivSafe)
+    Execute(Deallocate)
+    ExecuteStack(Sub32) ExecuteStack(SubFloat) ExecuteStack(Sub8)
+    Execute(SubReg)
+    ExecuteStack(SubSafe32) ExecuteStack(SubSafeFloat) ExecuteStack(SubSafe8)
+
+    L_Generic:
+        this->state.pc = ins->next;
+        this->ip = ins->follow;
+        code = ins->handler(*this, *ins);
+        this->Resync();
+        if (code != System::ErrorCode::Ok)
+            return this->Failed(*ins, code);
+        Promoted()
+        Dispatch()
+
+    L_Yield:
+        return System::ErrorCode::Ok;
+
+#undef ExecuteJump
+#undef ExecuteStack
+#undef Execute
+#undef Promoted
+#undef Dispatch
+#else
+    // Plain loop over the handler table.
+    for (;;)
     {
-        this->state.pc++;
-        code = ops[op](*this);
+        this->state.pc = ins->next;
+        this->ip = ins->follow;
+
+        code = ins->handler(*this, *ins);
+        this->Resync();
+
+        if (code != System::ErrorCode::Ok)
+            return this->Failed(*ins, code);
 
-        if (code == System::ErrorCode::Ok)
+        if (--budget == 0)
             return code;
 
+        ins = &this->Fetch();
+        if (ins->dispatch == Instruction::Yield)
+            return code;
+
+#ifdef ENABLE_JIT
+        if (this->jit != nullptr && this->jit->Get(this->ip) != nullptr)
+            return code;
+#endif
+    }
+#endif
+}
+
+template Error CPU::Burst<true>(sysbit_t& budget) noexcept;
+template Error CPU::Burst<false>(sysbit_t& budget) noexcept;
+
+Error CPU::Failed(const Instruction& ins, Error code) noexcept
+{
+    if (ins.handler == Fault && code == System::ErrorCode::InvalidInstruction)
+    {
         LOGE(
-            System::LogLevel::Medium,
+            System::LogLevel::Low,
             "In ", this->board.Stringify(),
-            ", error while executing the instruction ", OpCodesString(op),
-            ". Error code: ", System::ErrorCodeString(code)
+            ", error while executing the instruction '", std::to_string(ins.mode), 
+            "' at ROM index '", std::to_string(ins.pc),
+            "'. Instruction hasn't been implemented yet or instruction is wrong."
         );
-
         return code;
     }
 
     LOGE(
-        System::LogLevel::Low,
+        System::LogLevel::Medium,
         "In ", this->board.Stringify(),
-        ", error while executing the instruction '", OpCodesString(op), 
-        "' at ROM index '", std::to_string(this->state.pc),
-        "'. Instruction hasn't been implemented yet or instruction is wrong."
+        ", error while executing the instruction ", OpCodesString(ins.op),
+        ". Error code: ", System::ErrorCodeString(code)
     );
 
-    return System::ErrorCode::InvalidInstruction;
+    return code;
+}
+
+Error CPU::Overflow() const noexcept
+{
+    LOGE(
+        System::LogLevel::Medium,
+        "In ", this->board.GetExecutingProcess().Stringify(),
+        " can't push value onto stack, stack is full."
+    );
+    return System::ErrorCode::StackOverflow;
 }
 
+template<bool Safe>
 Error CPU::Push(const char value) noexcept 
 {
-    if (this->state.sp+1 > this->board.ram.StackSize())
+    if constexpr (!Safe)
     {
-        LOGE(
-            System::LogLevel::Medium,
-            "In ", this->board.GetExecutingProcess().Stringify(),
-            " can't push value onto stack, stack is full."
-        );
-        return System::ErrorCode::StackOverflow;
+        *this->board.ram.At(this->state.sp++) = value;
+        return System::ErrorCode::Ok;
     }
 
+    if (this->state.sp+1 > this->board.ram.StackSize())
+        return this->Overflow();
+
     Error errc { this->board.ram.Write(this->state.sp, value) };
 
     if (errc == System::ErrorCode::Ok)
@@ -140,9 +433,10 @@ Error CPU::Push(const char value) noexcept
     return errc;
 }
 
+template<bool Safe>
 Error CPU::Pop() noexcept
 {
-    if (this->state.sp < 1)
+    if (Safe && this->state.sp < 1)
     {
         LOGE(
             System::LogLevel::Medium,
@@ -158,18 +452,19 @@ Error CPU::Pop() noexcept
     return Error::Ok;
 }
 
+template<bool Safe>
 Error CPU::PushSome(const Slice values) noexcept
 {
-    if (this->state.sp+values.size > this->board.ram.StackSize())
+    if constexpr (!Safe)
     {
-        LOGE(
-            System::LogLevel::Medium,
-            "In ", this->board.GetExecutingProcess().Stringify(),
-            " can't push value onto stack, stack is full."
-        );
-        return System::ErrorCode::StackOverflow;
+        std::memmove(this->board.ram.At(this->state.sp), values.data, values.size);
+        this->state.sp += values.size;
+        return System::ErrorCode::Ok;
     }
 
+    if (this->state.sp+values.size > this->board.ram.StackSize())
+        return this->Overflow();
+
     Error errc { this->board.ram.WriteSome(this->state.sp, values) };
 
     if (errc == System::ErrorCode::Ok)
@@ -185,9 +480,10 @@ Error CPU::PushSome(const Slice values) noexcept
     return errc;
 }
 
+template<bool Safe>
 Error CPU::PopSome(const sysbit_t size) noexcept
 {
-    if (this->state.sp-size < 0)
+    if (Safe && this->state.sp-size < 0)
     {
         LOGE(
             System::LogLevel::Medium,
@@ -202,3 +498,12 @@ Error CPU::PopSome(const sysbit_t size) noexcept
     this->state.sp -= size;
     return Error::Ok;
 }
+
+template Error CPU::Push<true>(const char value) noexcept;
+template Error CPU::Push<false>(const char value) noexcept;
+template Error CPU::Pop<true>() noexcept;
+template Error CPU::Pop<false>() noexcept;
+template Error CPU::PushSome<true>(const Slice values) noexcept;
+template Error CPU::PushSome<false>(const Slice values) noexcept;
+template Error CPU::PopSome<true>(const sysbit_t size) noexcept;
+template Error CPU::PopSome<false>(const sysbit_t size) noexcept;
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "bytemode/handles.hpp"
+#include "bytemode/heap.hpp"
+#include "CSRConfig.hpp"
+
+//
+// Handles Implementation
+//
+Handles::Handles(const std::uint64_t span) :
+    pages(static_cast<sysbit_t>(span >> PageBits))
+{ }
+
+Handles::Handles(const Handles& other) :
+    blocks(other.blocks),
+    unused(other.unused),
+    pages(Heap::Image { other.pages }),
+    table(other.table)
+{ }
+
+bool Handles::Add(const sysbit_t offset, const sysbit_t size, sysbit_t& address)
+{
+    const sysbit_t count { PagesOf(size) };
+    sysbit_t page;
+    if (!this->pages.Allocate(count, page))
+        return false;
+
+    sysbit_t slot;
+    if (!this->unused.empty())
+    {
+        slot = this->unused.back();
+        this->unused.pop_back();
+    }
+    else
+    {
+        slot = static_cast<sysbit_t>(this->blocks.size());
+        this->blocks.emplace_back();
+    }
+
+    this->blocks[slot] = { offset, size, page };
+    if (this->table.size() < page+count)
+        this->table.resize(page+count);
+    std::fill_n(this->table.begin()+page, count, slot+1);
+
+    address = page << PageBits;
+    return true;
+}
+
+void Handles::Remove(const sysbit_t slot) noexcept
+{
+    const Block& block { this->blocks[slot] };
+    const sysbit_t count { PagesOf(block.size) };
+    this->pages.Free(block.page, count);
+    std::fill_n(this->table.begin()+block.page, count, 0);
+
+    this->blocks[slot] = { };
+    this->unused.push_back(slot);
+}
+
+std::vector<sysbit_t> Handles::ByOffset() const
+{
+    std::vector<sysbit_t> live;
+    for (sysbit_t slot = 0; slot < this->blocks.size(); slot++)
+        if (this->blocks[slot].size != 0)
+            live.push_back(slot);
+
+    std::sort(live.begin(), live.end(), [this](const sysbit_t lhs, const sysbit_t rhs) {
+        return this->blocks[lhs].offset < this->blocks[rhs].offset;
+    });
+    return live;
+}
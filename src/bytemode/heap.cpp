@@ -0,0 +1,339 @@
+#include <algorithm>
+#include <bit>
+
+#include "extensions/syntaxextensions.hpp"
+#include "bytemode/heap.hpp"
+#include "CSRConfig.hpp"
+#include "platform.hpp"
+
+namespace
+{
+    std::uint64_t Mask(const sysbit_t bit, const sysbit_t span) noexcept
+    { return (span == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << span)-1) << bit; }
+}
+
+template<typename T>
+std::unique_ptr<T[], Heap::Release> Heap::Pages(const std::size_t count) noexcept
+{
+    const std::size_t page { PageSize() };
+    const std::size_t size { std::max(page, (count*sizeof(T)+page-1)/page*page) };
+
+    void* memory { MemReserve(size) };
+    if (memory != nullptr && !MemCommit(memory, size))
+    {
+        MemRelease(memory, size);
+        memory = nullptr;
+    }
+    return { static_cast<T*>(memory), Release { size } };
+}
+
+void Heap::Release::operator()(void* memory) const noexcept
+{
+    MemRelease(memory, this->size);
+}
+
+//
+// Heap Implementation
+//
+Heap::Heap(sysbit_t size) :
+    map(Pages<std::uint64_t>((size+63)/64)),
+    size(size),
+    words((size+63)/64),
+    freeCells(size)
+{
+    this->Build(0);
+}
+
+Heap::Heap(const Image& image) :
+    map(Pages<std::uint64_t>(image.source.words)),
+    tree(Pages<Runs>(2*image.source.leaves)),
+    size(image.source.size),
+    words(image.source.words),
+    leaves(image.source.leaves),
+    freeCells(image.source.freeCells),
+    touched(image.source.touched)
+{
+    const Heap& source { image.source };
+    if (
+        MemMapSnapshot(image.map, this->map.get(), this->map.get_deleter().size)
+        && MemMapSnapshot(image.tree, this->tree.get(), this->tree.get_deleter().size)
+    )
+        return;
+
+    std::copy_n(source.map.get(), source.words, this->map.get());
+    std::copy_n(source.tree.get(), 2*source.leaves, this->tree.get());
+}
+
+Heap::Image::Image(const Heap& source) noexcept :
+    source(source),
+    map(MemSnapshot(source.map.get(), source.map.get_deleter().size)),
+    tree(MemSnapshot(source.tree.get(), source.tree.get_deleter().size))
+{ }
+
+Heap::Image::~Image()
+{
+    MemDropSnapshot(this->map);
+    MemDropSnapshot(this->tree);
+}
+
+void Heap::Build(const sysbit_t used) noexcept
+{
+    // cells past the end are never free
+    if (this->size % 64 != 0)
+        this->map[this->words-1] |= ~Mask(0, this->size%64);
+
+    const sysbit_t leafCount { std::max<sysbit_t>(1, (this->words+LeafWords-1)/LeafWords) };
+    this->leaves = std::bit_ceil(leafCount);
+    this->tree = Pages<Runs>(2*this->leaves);
+
+    if (this->size == 0)
+        return;
+
+    // everything else is untouched and reads as free
+    const sysbit_t usedLeaves { (used+LeafCells-1)/LeafCells };
+    const sysbit_t last { this->leaves+leafCount-1 };
+    for (sysbit_t leaf = 0; leaf < usedLeaves; leaf++)
+        this->SetNode(this->leaves+leaf, LeafCells, this->Summarise(leaf));
+    this->SetNode(last, LeafCells, this->Summarise(leafCount-1));
+
+    // and whatever lies past the last leaf is in use
+    std::uint64_t span { LeafCells };
+    for (sysbit_t node = last; node > 1; node /= 2, span *= 2)
+        if (node % 2 == 0)
+            this->SetNode(node+1, span, { });
+
+    if (usedLeaves != 0)
+        this->Propagate(this->leaves, this->leaves+usedLeaves-1);
+    this->Propagate(last, last);
+}
+
+// Spans over 2^32 cells wrap, but a run never gets that long so the
+// difference still comes back right
+Heap::Runs Heap::Node(const sysbit_t node, const std::uint64_t span) const noexcept
+{
+    const Runs& stored { this->tree[node] };
+    const sysbit_t cells { static_cast<sysbit_t>(span) };
+    return { cells-stored.head, cells-stored.tail, cells-stored.longest };
+}
+
+void Heap::SetNode(const sysbit_t node, const std::uint64_t span, const Runs& runs) noexcept
+{
+    const sysbit_t cells { static_cast<sysbit_t>(span) };
+    this->tree[node] = { cells-runs.head, cells-runs.tail, cells-runs.longest };
+}
+
+bool Heap::Allocate(const sysbit_t size, sysbit_t& offset) noexcept
+{
+    std::uint64_t cells { std::uint64_t{LeafCells}*this->leaves };
+    if (size == 0 || size > this->freeCells || this->Node(1, cells).longest < size)
+        return false;
+
+    // Leftmost first: a run inside the left half, then one crossing
+    // the middle, then the right half.
+    sysbit_t node { 1 };
+    sysbit_t base { 0 };
+    bool found { false };
+    while (node < this->leaves && !found)
+    {
+        cells /= 2;
+        const Runs left { this->Node(2*node, cells) };
+        const Runs right { this->Node(2*node+1, cells) };
+
+        if (left.longest >= size)
+            node = 2*node;
+        else if (std::uint64_t{left.tail}+right.head >= size)
+        {
+            offset = static_cast<sysbit_t>(base+cells-left.tail);
+            found = true;
+        }
+        else
+        {
+            node = 2*node+1;
+            base += cells;
+        }
+    }
+
+    if (!found)
+        offset = this->FindInLeaf(node-this->leaves, size);
+
+    this->freeCells -= this->Mark(offset, size, true);
+    this->Update(offset, size);
+    return true;
+}
+
+void Heap::Free(const sysbit_t offset, const sysbit_t size) noexcept
+{
+    if (size == 0)
+        return;
+
+    this->freeCells += this->Mark(offset, size, false);
+    this->Update(offset, size);
+}
+
+void Heap::Grow(const sysbit_t size) noexcept
+{
+    if (size <= this->size)
+        return;
+
+    const sysbit_t words { (size+63)/64 };
+    std::unique_ptr<std::uint64_t[], Release> map { Pages<std::uint64_t>(words) };
+    std::copy_n(this->map.get(), this->touched, map.get());
+
+    // the old end's padding is free cells now
+    if (this->size % 64 != 0)
+        map[this->words-1] &= Mask(0, this->size%64);
+
+    const sysbit_t used { static_cast<sysbit_t>(std::min<std::uint64_t>(std::uint64_t{this->touched}*64, this->size)) };
+    this->freeCells += size-this->size;
+    this->map = rval(map);
+    this->size = size;
+    this->words = words;
+    this->Build(used);
+}
+
+sysbit_t Heap::FreeTail() const noexcept
+{
+    sysbit_t tail { 0 };
+    for (sysbit_t i = this->words; i-- > 0; )
+    {
+        // only the cells before the end count in the last word
+        const sysbit_t cells { i == this->words-1 && this->size%64 != 0 ? this->size%64 : 64 };
+        const sysbit_t free { std::min<sysbit_t>(std::countl_zero(this->map[i] << (64-cells)), cells) };
+        tail += free;
+        if (free != cells)
+            break;
+    }
+
+    return tail;
+}
+
+sysbit_t Heap::LargestRun() const noexcept
+{
+    if (this->size == 0)
+        return 0;
+    return this->Node(1, std::uint64_t{LeafCells}*this->leaves).longest;
+}
+
+Heap::Runs Heap::Summarise(const sysbit_t leaf) const noexcept
+{
+    Runs runs;
+    sysbit_t run { 0 };
+    bool atHead { true };
+    const auto EndRun { [&]() {
+        if (atHead)
+            runs.head = run;
+        atHead = false;
+        runs.longest = std::max(runs.longest, run);
+        run = 0;
+    }};
+
+    const sysbit_t first { leaf*LeafWords };
+    const sysbit_t last { std::min(first+LeafWords, this->words) };
+    for (sysbit_t i = first; i < last; i++)
+    {
+        const std::uint64_t word { this->map[i] };
+        for (sysbit_t bit = 0; bit < 64; )
+        {
+            const sysbit_t free { std::min<sysbit_t>(std::countr_zero(word >> bit), 64-bit) };
+            run += free;
+            bit += free;
+            if (bit == 64)
+                break;
+
+            EndRun();
+            bit += std::countr_one(word >> bit);
+        }
+    }
+
+    // the last leaf may stop short, cells past the end are in use
+    if (last-first < LeafWords)
+        EndRun();
+
+    if (atHead)
+        runs.head = run;
+    runs.tail = run;
+    runs.longest = std::max(runs.longest, run);
+    return runs;
+}
+
+sysbit_t Heap::FindInLeaf(const sysbit_t leaf, const sysbit_t size) const noexcept
+{
+    const sysbit_t first { leaf*LeafWords };
+    const sysbit_t last { std::min(first+LeafWords, this->words) };
+
+    sysbit_t start { first*64 };
+    sysbit_t run { 0 };
+    for (sysbit_t i = first; i < last; i++)
+    {
+        const std::uint64_t word { this->map[i] };
+        for (sysbit_t bit = 0; bit < 64; )
+        {
+            const sysbit_t free { std::min<sysbit_t>(std::countr_zero(word >> bit), 64-bit) };
+            run += free;
+            bit += free;
+            if (run >= size)
+                return start;
+            if (bit == 64)
+                break;
+
+            bit += std::countr_one(word >> bit);
+            run = 0;
+            start = i*64+bit;
+        }
+    }
+
+    // the tree said there's one
+    return start;
+}
+
+sysbit_t Heap::Mark(const sysbit_t offset, const sysbit_t size, const bool used) noexcept
+{
+    sysbit_t changed { 0 };
+    const std::uint64_t end { std::uint64_t{offset}+size };
+    for (std::uint64_t cell = offset; cell < end; )
+    {
+        const sysbit_t bit { static_cast<sysbit_t>(cell%64) };
+        const sysbit_t span { static_cast<sysbit_t>(std::min<std::uint64_t>(64-bit, end-cell)) };
+        const std::uint64_t mask { Mask(bit, span) };
+        std::uint64_t& word { this->map[cell/64] };
+        this->touched = std::max(this->touched, static_cast<sysbit_t>(cell/64+1));
+
+        changed += std::popcount(used ? mask & ~word : mask & word);
+        word = used ? word | mask : word & ~mask;
+        cell += span;
+    }
+
+    return changed;
+}
+
+void Heap::Update(const sysbit_t offset, const sysbit_t size) noexcept
+{
+    const sysbit_t low { this->leaves+offset/LeafCells };
+    const sysbit_t high { this->leaves+(offset+size-1)/LeafCells };
+    for (sysbit_t node = low; node <= high; node++)
+        this->SetNode(node, LeafCells, this->Summarise(node-this->leaves));
+
+    this->Propagate(low, high);
+}
+
+void Heap::Propagate(sysbit_t low, sysbit_t high) noexcept
+{
+    std::uint64_t cells { LeafCells };
+    while (low > 1)
+    {
+        low /= 2;
+        high /= 2;
+        for (sysbit_t node = low; node <= high; node++)
+        {
+            const Runs left { this->Node(2*node, cells) };
+            const Runs right { this->Node(2*node+1, cells) };
+
+            this->SetNode(node, 2*cells, {
+                .head = left.head == cells ? static_cast<sysbit_t>(cells+right.head) : left.head,
+                .tail = right.tail == cells ? static_cast<sysbit_t>(cells+left.tail) : right.tail,
+                .longest = std::max({ left.longest, right.longest, left.tail+right.head })
+            });
+        }
+        cells *= 2;
+    }
+}
@@ -1,7 +1,10 @@
+#include <algorithm>
 #include <cstring>
 #include <string>
 #include <array>
 #include <cmath>
+#include <bit>
+#include <type_traits>
 
 #include "extensions/syntaxextensions.hpp"
 #include "extensions/converters.hpp"
@@ -12,209 +15,309 @@
 #include "CSRConfig.hpp"
 #include "system.hpp"
 
+#ifdef ENABLE_JIT
+    #include "jit/jit.hpp"
+#endif
+
 #define OPR Error
 #define NOT_IMP(name) \
         LOGE(System::LogLevel::Low, "Implement ", #name); \
         return System::ErrorCode::Ok;
 
-#define Enumc(regn) static_cast<char>(regn)
-#define Is8BitReg(reg) (Enumc(reg) >= Enumc(RegisterModeFlags::al)) && (Enumc(reg) <= Enumc(RegisterModeFlags::flg))
 #define RomSafetyCheck(addr) \
         if (address < 12 || address > cpu.board.assembly.Rom().Size()) \
             return Error::ROMAccessError;
 
+// Calls and back-edges count towards promoting where they land to the JIT.
+#ifdef ENABLE_JIT
+    #define Heat(index) \
+            (cpu.jit != nullptr ? cpu.jit->Heat(index) : void())
+#else
+    #define Heat(index) static_cast<void>(0)
+#endif
+
+// Handlers don't throw, a failed RAM access hands its error to the CPU
+// which reports it.
+#define ReadSomeChecked(into, address, size) \
+        const char* into; \
+        if (Error readErr { cpu.board.ram.ReadSome(address, size, into) }; readErr != System::ErrorCode::Ok) \
+            return readErr;
+
+// Stack reads in handlers taking Safe. Without it the verifier has already
+// proven the address is on the stack.
+#define StackReadSome(into, address, size) \
+        const char* into; \
+        if constexpr (Safe) \
+        { \
+            if (Error readErr { cpu.board.ram.ReadSome(address, size, into) }; readErr != System::ErrorCode::Ok) \
+                return readErr; \
+        } \
+        else \
+            into = cpu.board.ram.At(address);
+
+
+// Register operands index CPU::State's register files directly. The
+// decoder rejects unknown registers and registers whose width doesn't fit
+// the opcode, handlers that take either width check it themselves.
+static_assert(
+    sizeof(CPU::State::wide)/sizeof(sysbit_t) == Enumc(RegisterModeFlags::al)-Enumc(RegisterModeFlags::eax)
+    && sizeof(CPU::State::narrow) == Enumc(RegisterModeFlags::flg)-Enumc(RegisterModeFlags::al)+1
+);
+
+static inline sysbit_t& GetRegister32Bit(RegisterModeFlags reg, CPU::State& state) noexcept
+{
+    return state.wide[Enumc(reg)-Enumc(RegisterModeFlags::eax)];
+}
+
+static inline uchar_t& GetRegister8Bit(RegisterModeFlags reg, CPU::State& state) noexcept
+{
+    return state.narrow[Enumc(reg)-Enumc(RegisterModeFlags::al)];
+}
+
+//
+// Typed stack access, see cpu.hpp
+//
+template<typename T>
+static inline T LoadValue(const char* at) noexcept
+{
+    if constexpr (std::is_floating_point_v<T>)
+        return FloatFromRam(at);
+    else
+        return IntegerFromRam<T>(at);
+}
+
+template<typename T>
+static inline void StoreValue(char* at, const T value) noexcept
+{
+    if constexpr (std::is_floating_point_v<T>)
+        FloatToRam(value, at);
+    else
+        IntegerToRam(value, at);
+}
+
+template<typename T, bool Safe>
+inline Error CPU::PushValue(const T value) noexcept
+{
+    if (Safe && this->state.sp+sizeof(T) > this->board.ram.StackSize())
+        return this->Overflow();
+
+    StoreValue(this->board.ram.At(this->state.sp), value);
+    this->state.sp += sizeof(T);
+    return System::ErrorCode::Ok;
+}
+
+// Reading past the bottom of the stack fails like the RAM read below
+// address 0 it stands for.
+template<typename T, bool Safe>
+inline Error CPU::PeekValue(T& value, const sysbit_t depth) noexcept
+{
+    if (Safe && this->state.sp < depth)
+        return System::ErrorCode::RAMAccessError;
+
+    value = LoadValue<T>(this->board.ram.At(this->state.sp-depth));
+    return System::ErrorCode::Ok;
+}
 
-static sysbit_t& GetRegister32Bit(RegisterModeFlags reg, CPU::State& state)
+template<typename T, bool Safe, bool Keep, typename Op>
+inline Error CPU::Unary(Op op) noexcept
 {
-    static sysbit_t dummy { 0 };
-    switch (reg)
+    if (Safe && this->state.sp < sizeof(T))
+        return System::ErrorCode::RAMAccessError;
+    if (Safe && Keep && this->state.sp+sizeof(T) > this->board.ram.StackSize())
+        return this->Overflow();
+
+    char* top { this->board.ram.At(this->state.sp-sizeof(T)) };
+    const T result = op(LoadValue<T>(top));
+
+    if constexpr (Keep)
     {
-        case RegisterModeFlags::eax: return state.eax;
-        case RegisterModeFlags::ebx: return state.ebx;
-        case RegisterModeFlags::ecx: return state.ecx;
-        case RegisterModeFlags::edx: return state.edx;
-        case RegisterModeFlags::esi: return state.esi;
-        case RegisterModeFlags::edi: return state.edi;
-        case RegisterModeFlags::pc: return state.pc;
-        case RegisterModeFlags::sp: return state.sp;
-        case RegisterModeFlags::bp: return state.bp;
-        default: 
-            CRASH(
-                System::ErrorCode::InvalidSpecifier,
-                RegisterModeFlagsString(reg), " is not a 32bit register."
-            );
-            return dummy;
-    } 
+        StoreValue(top+sizeof(T), result);
+        this->state.sp += sizeof(T);
+    }
+    else
+        StoreValue(top, result);
+
+    return System::ErrorCode::Ok;
 }
 
-static uchar_t& GetRegister8Bit(RegisterModeFlags reg, CPU::State& state)
+template<typename T, bool Safe, bool Keep, typename Op>
+inline Error CPU::Binary(Op op) noexcept
 {
-    static uchar_t dummy { 0 };
-    switch (reg)
+    if (Safe && this->state.sp < 2*sizeof(T))
+        return System::ErrorCode::RAMAccessError;
+    if (Safe && Keep && this->state.sp+sizeof(T) > this->board.ram.StackSize())
+        return this->Overflow();
+
+    char* lhs { this->board.ram.At(this->state.sp-2*sizeof(T)) };
+    const T result = op(LoadValue<T>(lhs), LoadValue<T>(lhs+sizeof(T)));
+
+    if constexpr (Keep)
     {
-        case RegisterModeFlags::al: return state.al;
-        case RegisterModeFlags::bl: return state.bl;
-        case RegisterModeFlags::cl: return state.cl;
-        case RegisterModeFlags::dl: return state.dl;
-        case RegisterModeFlags::flg: return state.flg;
-        default:
-            CRASH(
-                System::ErrorCode::InvalidSpecifier,
-                RegisterModeFlagsString(reg), " is not an 8bit register."
-            );
-            return dummy;
+        StoreValue(lhs+2*sizeof(T), result);
+        this->state.sp += sizeof(T);
+    }
+    else
+    {
+        StoreValue(lhs, result);
+        this->state.sp -= sizeof(T);
     }
+
+    return System::ErrorCode::Ok;
+}
+
+template<bool Safe>
+inline Error CPU::PushU32(const sysbit_t value) noexcept
+{ return this->PushValue<sysbit_t, Safe>(value); }
+
+template<bool Safe>
+inline Error CPU::PushF32(const float value) noexcept
+{ return this->PushValue<float, Safe>(value); }
+
+template<bool Safe>
+inline Error CPU::PushU8(const uchar_t value) noexcept
+{ return this->PushValue<uchar_t, Safe>(value); }
+
+template<bool Safe>
+inline Error CPU::PopU32(sysbit_t& value) noexcept
+{
+    Error err { this->PeekValue<sysbit_t, Safe>(value, 4) };
+    this->state.sp -= err == System::ErrorCode::Ok ? 4 : 0;
+    return err;
+}
+
+template<bool Safe>
+inline Error CPU::PopF32(float& value) noexcept
+{
+    Error err { this->PeekValue<float, Safe>(value, 4) };
+    this->state.sp -= err == System::ErrorCode::Ok ? 4 : 0;
+    return err;
+}
+
+template<bool Safe>
+inline Error CPU::PopU8(uchar_t& value) noexcept
+{
+    Error err { this->PeekValue<uchar_t, Safe>(value, 1) };
+    this->state.sp -= err == System::ErrorCode::Ok ? 1 : 0;
+    return err;
 }
 
-OPR CPU::NoOperation(CPU& cpu) noexcept
+template<bool Safe>
+inline Error CPU::PeekU32(sysbit_t& value, const sysbit_t depth) noexcept
+{ return this->PeekValue<sysbit_t, Safe>(value, depth); }
+
+template<bool Safe>
+inline Error CPU::PeekF32(float& value, const sysbit_t depth) noexcept
+{ return this->PeekValue<float, Safe>(value, depth); }
+
+template<bool Safe>
+inline Error CPU::PeekU8(uchar_t& value, const sysbit_t depth) noexcept
+{ return this->PeekValue<uchar_t, Safe>(value, depth); }
+
+OPR CPU::NoOperation(CPU& cpu, const Instruction& ins) noexcept
 {
     // nop
     return System::ErrorCode::Ok;
 }
 
-OPR CPU::StoreThirtyTwo(CPU& cpu) noexcept
+OPR CPU::Fault(CPU& cpu, const Instruction& ins) noexcept
+{
+    // not an instruction, decoder stored the error in imm
+    return System::ErrorCode(ins.imm);
+}
+
+template<bool Safe>
+OPR CPU::StoreThirtyTwo(CPU& cpu, const Instruction& ins) noexcept
 {
     // stc %i/ui/f <value>
     // stt <byte0..1..2..3>
-    
-    try_catch(
-        Error err { cpu.PushSome(cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4)) };
-        if (err == System::ErrorCode::Ok)
-            cpu.state.pc+=4;
-        return err;,
-
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    ) 
+    return cpu.PushU32<Safe>(IntegerFromBytes<sysbit_t>(ins.data));
 }
 
-OPR CPU::StoreEight(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::StoreEight(CPU& cpu, const Instruction& ins) noexcept
 {
     // stc %b/ub <value>
     // ste <byte>
-    try_catch(
-        Error code { cpu.Push(cpu.board.assembly.Rom().Read(cpu.state.pc)) };
-        if (code == System::ErrorCode::Ok)
-        cpu.state.pc++;
-        return code;,
-
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    return cpu.PushU8<Safe>(ins.data[0]);
 }
 
-OPR CPU::StoreFromSymbol(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::StoreFromSymbol(CPU& cpu, const Instruction& ins) noexcept
 {
     // stc %i/ui/f <symbol>
     // stc %b/ub <symbol>
     //
     // stt <byte0..1..2..3>
     // ste <byte0..1..2..3>
-    try_catch(
-        sysbit_t size { 
-            static_cast<sysbit_t>
-            (cpu.board.assembly.Rom().Read(cpu.state.pc-1) == (char)OpCodes::stes ? 1 : 4)
-        };
-
-        const Slice symbolData { cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4) };
-        const sysbit_t symbol { IntegerFromBytes<sysbit_t>(symbolData.data) };
-        const Slice valueData { cpu.board.assembly.Rom().ReadSome(symbol, size) };
-
-        Error err { cpu.PushSome(valueData) };
-        if (err == Error::Ok)
-            cpu.state.pc+=4;     
-        return err;,
+    // symbol address was range checked when decoded
+    if (ins.op == OpCodes::stes)
+        return cpu.PushU8<Safe>(ins.data[0]);
 
-        return exc.GetCode();,
-        return Error::UnhandledException;
-    )
+    return cpu.PushU32<Safe>(IntegerFromBytes<sysbit_t>(ins.data));
 }
 
-OPR CPU::LoadFromStack(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::LoadFromStack(CPU& cpu, const Instruction& ins) noexcept
 {
     // ldc %i/ui/f
     // ldc %b/ub
     //
     // ldt
     // lde
-    try_catch(
-        sysbit_t size {
-            static_cast<sysbit_t>
-            (cpu.board.assembly.Rom().Read(cpu.state.pc-1) == (char)OpCodes::ldt ? 4 : 1)
-        };
+    sysbit_t size {
+        static_cast<sysbit_t>
+        (ins.op == OpCodes::ldt ? 4 : 1)
+    };
 
-        const Slice values { cpu.board.ram.ReadSome(cpu.state.sp-size, size) };
-        // ldc no longer allocates memory itself.
-        // it should be allocated and address must be put on &ebx beforehand
-        //const sysbit_t alloc { cpu.board.ram.Allocate(size) };
+    StackReadSome(valuesData, cpu.state.sp-size, size)
+    const Slice values { valuesData, size };
+    // ldc no longer allocates memory itself.
+    // it should be allocated and address must be put on &ebx beforehand
+    //const sysbit_t alloc { cpu.board.ram.Allocate(size) };
 
-        Error errc { cpu.board.ram.WriteSome(cpu.state.ebx, values) };
-        if (errc != System::ErrorCode::Ok)
-            // even though we didn't allocate here, we free in case of an error.
-             return cpu.board.ram.Deallocate(cpu.state.ebx, size);
+    Error errc { cpu.board.ram.WriteSome(cpu.state.ebx, values) };
+    if (errc != System::ErrorCode::Ok)
+        // even though we didn't allocate here, we free in case of an error.
+         return cpu.board.ram.Deallocate(cpu.state.ebx, size);
 
-        return errc;, 
-
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    return errc;
 }
 
-OPR CPU::ReadFromHeap(CPU& cpu) noexcept
+OPR CPU::ReadFromHeap(CPU& cpu, const Instruction& ins) noexcept
 {
     // rda %i/ui/f/b//ub
     //
     // rdt
     // rde
-    try_catch(
-        sysbit_t size {
-            static_cast<sysbit_t>
-            (cpu.board.assembly.Rom().Read(cpu.state.pc-1) == (char)OpCodes::rdt ? 4 : 1) 
-        };
-
-        const Slice values { cpu.board.ram.ReadSome(cpu.state.ebx, size) };
+    sysbit_t size {
+        static_cast<sysbit_t>
+        (ins.op == OpCodes::rdt ? 4 : 1) 
+    };
 
-        Error errc { cpu.PushSome(values) };
-        if (errc != System::ErrorCode::Ok)
-            return errc;
+    ReadSomeChecked(valuesData, cpu.state.ebx, size)
+    const Slice values { valuesData, size };
 
-        return errc;,
+    Error errc { cpu.PushSome(values) };
+    if (errc != System::ErrorCode::Ok)
+        return errc;
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    return errc;
 }
 
-OPR CPU::ReadFromRegister(CPU& cpu) noexcept
+OPR CPU::ReadFromRegister(CPU& cpu, const Instruction& ins) noexcept
 {
     // rda &eax/ebx/ecx/edx/esi/edi/al/bl/cl/dl/flg/pc/sp
     //
     // rdr <byte>
-    try_catch(
-        RegisterModeFlags reg { cpu.board.assembly.Rom().Read(cpu.state.pc) };
-        sysbit_t size { Is8BitReg(reg) ? sysbit_t{1} : sysbit_t{4} };
-        char* data;
-
-        if (Is8BitReg(reg))
-            data = BytesFromInteger<uchar_t>(GetRegister8Bit(reg, cpu.state));
-        else
-            data = BytesFromInteger<sysbit_t>(GetRegister32Bit(reg, cpu.state));
+    RegisterModeFlags reg { ins.reg1 };
 
-        Error err = cpu.PushSome({
-            data,
-            size
-        });
-        
-        delete[] data;
-        cpu.state.pc++;
-        return err;,
+    if (Is8BitReg(reg))
+        return cpu.PushU8(GetRegister8Bit(reg, cpu.state));
 
-        return exc.GetCode();,
-        return Error::UnhandledException;
-    )
+    return cpu.PushU32(GetRegister32Bit(reg, cpu.state));
 }
 
-OPR CPU::Move(CPU& cpu) noexcept
+OPR CPU::Move(CPU& cpu, const Instruction& ins) noexcept
 {
     // mov &eax/ebx/ecx/edx/esi/edi/al/bl/cl/dl/flg/pc/sp
     // mov &eax/ebx/ecx/edx/esi/edi/al/bl/cl/dl/flg/pc/sp &eax/ebx/ecx/edx/esi/edi/al/bl/cl/dl/flg/pc/sp
@@ -224,285 +327,139 @@ OPR CPU::Move(CPU& cpu) noexcept
     // movr <byte> <byte>
     // movc <byte> <byte>
     // movc <byte> <byte0..1..2..3>
-    try_catch(
-        System::ErrorCode err;
-        RegisterModeFlags regFlag { cpu.board.assembly.Rom().Read(cpu.state.pc) };
-        sysbit_t size { Is8BitReg(regFlag) ? sysbit_t{1} : sysbit_t{4} };
+    System::ErrorCode err;
+    RegisterModeFlags regFlag { ins.reg1 };
+    sysbit_t size { Is8BitReg(regFlag) ? sysbit_t{1} : sysbit_t{4} };
 
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1)))
+    switch (ins.op)
+    {
+        case OpCodes::movc:
         {
-            case OpCodes::movc:
-            {
-                if (size == 1)
-                {
-                    GetRegister8Bit(regFlag, cpu.state) = cpu.board.assembly.Rom().Read(cpu.state.pc+1);
-                    cpu.state.pc+=2;
-                }
-                else
-                {
-                    GetRegister32Bit(regFlag, cpu.state) = IntegerFromBytes<sysbit_t>(
-                        cpu.board.assembly.Rom().ReadSome(cpu.state.pc+1, 4).data
-                    );
-                    cpu.state.pc+=5;
-                }
-                return System::ErrorCode::Ok;
-            }
-            
-            case OpCodes::movs:
+            if (size == 1)
             {
-                if (size == 1)
-                    GetRegister8Bit(regFlag, cpu.state) = IntegerFromBytes<uchar_t>(
-                        cpu.board.ram.ReadSome(cpu.state.sp-1, 1).data
-                    );
-                else
-                    GetRegister32Bit(regFlag, cpu.state) = IntegerFromBytes<sysbit_t>(
-                        cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data
-                    );
-
-                cpu.state.pc++;
-                return System::ErrorCode::Ok;
+                GetRegister8Bit(regFlag, cpu.state) = static_cast<uchar_t>(ins.imm);
             }
-
-            case OpCodes::movr:
+            else
             {
-                RegisterModeFlags reg2Flag { cpu.board.assembly.Rom().Read(cpu.state.pc+1)};
-                sysbit_t size2 { Is8BitReg(reg2Flag) ? sysbit_t{1} : sysbit_t{4} };
-                sysbit_t val;
-
-                if (size == 1)
-                    val = static_cast<sysbit_t>(GetRegister8Bit(regFlag, cpu.state));
-                else
-                    val = GetRegister32Bit(regFlag, cpu.state);
-
-                if (size2 == 1)
-                    GetRegister8Bit(reg2Flag, cpu.state) = val;
-                else
-                    GetRegister32Bit(reg2Flag, cpu.state) = val;
-                cpu.state.pc+=2;
-                return System::ErrorCode::Ok;
+                GetRegister32Bit(regFlag, cpu.state) = ins.imm;
             }
+            return System::ErrorCode::Ok;
+        }
+        
+        case OpCodes::movs:
+        {
+            if (size == 1)
+                return cpu.PeekU8(GetRegister8Bit(regFlag, cpu.state));
 
-            default:
-                return System::ErrorCode::InvalidInstruction;
-        },
-
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    ) 
-}
+            return cpu.PeekU32(GetRegister32Bit(regFlag, cpu.state));
+        }
 
-OPR CPU::Add32(CPU& cpu) noexcept
-{
-    try_catch(
-        sysbit_t int1;
-        sysbit_t int2;
-        int1 = IntegerFromBytes<sysbit_t>(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data);
-        cpu.PopSome(4);
-        int2 = IntegerFromBytes<sysbit_t>(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data);
-        cpu.PopSome(4);
+        case OpCodes::movr:
+        {
+            RegisterModeFlags reg2Flag { ins.reg2 };
+            sysbit_t size2 { Is8BitReg(reg2Flag) ? sysbit_t{1} : sysbit_t{4} };
+            sysbit_t val;
 
-        char* data { BytesFromInteger(int1+int2) };
-        Error err { cpu.PushSome({
-            data,
-            4
-        })};
+            if (size == 1)
+                val = static_cast<sysbit_t>(GetRegister8Bit(regFlag, cpu.state));
+            else
+                val = GetRegister32Bit(regFlag, cpu.state);
 
-        delete[] data;
-        return err;,
+            if (size2 == 1)
+                GetRegister8Bit(reg2Flag, cpu.state) = val;
+            else
+                GetRegister32Bit(reg2Flag, cpu.state) = val;
+            return System::ErrorCode::Ok;
+        }
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+        default:
+            return System::ErrorCode::InvalidInstruction;
+    }
 }
 
-OPR CPU::AddFloat(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::Add32(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        float float1;
-        float float2;
-        float1 = FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data);
-        cpu.PopSome(4);
-        float2 = FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data);
-        cpu.PopSome(4);
-
-        char* data { BytesFromFloat<char>(float1+float2) };
-        Error err { cpu.PushSome({
-            data,
-            4
-        })};
-
-        delete[] data;
-        return err;,
-
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    return cpu.Binary<sysbit_t, Safe>([](sysbit_t lhs, sysbit_t rhs) { return lhs+rhs; });
 }
 
-OPR CPU::Add8(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::AddFloat(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        uchar_t byte1;
-        uchar_t byte2;
-        byte1 = cpu.board.ram.Read(cpu.state.sp-1);
-        cpu.Pop();
-        byte2 = cpu.board.ram.Read(cpu.state.sp-1);
-        cpu.Pop();
-        
-        Error err { cpu.Push(byte1+byte2) };
-        return err;,
-
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    return cpu.Binary<float, Safe>([](float lhs, float rhs) { return lhs+rhs; });
 }
 
-OPR CPU::AddReg(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::Add8(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        OpCodes op { cpu.board.assembly.Rom().Read(cpu.state.pc-1) };
-        RegisterModeFlags reg1 { cpu.board.assembly.Rom().Read(cpu.state.pc) };
-        RegisterModeFlags reg2 { cpu.board.assembly.Rom().Read(cpu.state.pc+1) };
-        
-        if (
-            /*case 1*/ 
-            ((op == OpCodes::addrb)
-            &&
-            (!Is8BitReg(reg1) || !Is8BitReg(reg2)))
-            ||
-
-            /*case 2*/
-            ((op != OpCodes::addrb)
-            &&
-            (Is8BitReg(reg1) || Is8BitReg(reg2)))
-        )
-            CRASH(System::ErrorCode::InvalidSpecifier,
-                "In ", cpu.board.Stringify(), ", PC: ", std::to_string(cpu.state.pc-1),
-                " ", OpCodesString(op),
-                " ", RegisterModeFlagsString(reg1),
-                " ", RegisterModeFlagsString(reg2),
-                " Given registers are not compatible with given numeric type."
-            );
-
-        cpu.state.pc+=2;
-
-        if (Is8BitReg(reg1))
-        {
-            uchar_t reg1ref { GetRegister8Bit(reg1, cpu.state) };
-            uchar_t& reg2ref { GetRegister8Bit(reg2, cpu.state) };
-            reg2ref += reg1ref;
-        }
-        else if (op == OpCodes::addrf)
-        {
-            sysbit_t reg1ref { GetRegister32Bit(reg1, cpu.state) };
-            sysbit_t& reg2ref { GetRegister32Bit(reg2, cpu.state) };
+    return cpu.Binary<uchar_t, Safe>([](uchar_t lhs, uchar_t rhs) { return lhs+rhs; });
+}
 
-            char* data { BytesFromInteger(reg1ref) };
-            float float1 { FloatFromBytes(
-                data
-            )};
-            delete[] data;
+OPR CPU::AddReg(CPU& cpu, const Instruction& ins) noexcept
+{
+    OpCodes op { ins.op };
+    RegisterModeFlags reg1 { ins.reg1 };
+    RegisterModeFlags reg2 { ins.reg2 };
+    
+    // register widths were checked against the opcode when decoded
+    if (Is8BitReg(reg1))
+    {
+        uchar_t reg1ref { GetRegister8Bit(reg1, cpu.state) };
+        uchar_t& reg2ref { GetRegister8Bit(reg2, cpu.state) };
+        reg2ref += reg1ref;
+    }
+    else if (op == OpCodes::addrf)
+    {
+        sysbit_t reg1ref { GetRegister32Bit(reg1, cpu.state) };
+        sysbit_t& reg2ref { GetRegister32Bit(reg2, cpu.state) };
 
-            data = BytesFromInteger(reg2ref);
-            float float2 { FloatFromBytes(
-                data
-            )};
-            delete[] data;
+        float float1 { std::bit_cast<float>(reg1ref)};
 
-            data = BytesFromFloat(float1+float2);
-            reg2ref = IntegerFromBytes<sysbit_t>(
-                data
-            );
-            delete[] data;
-        }
-        else
-        {
-            sysbit_t reg1ref { GetRegister32Bit(reg1, cpu.state) };
-            sysbit_t& reg2ref { GetRegister32Bit(reg2, cpu.state) };
-            reg2ref += reg1ref;
-        }
+        float float2 { std::bit_cast<float>(reg2ref)};
 
-        return System::ErrorCode::Ok;,
+        reg2ref = std::bit_cast<sysbit_t>(float1+float2);
+    }
+    else
+    {
+        sysbit_t reg1ref { GetRegister32Bit(reg1, cpu.state) };
+        sysbit_t& reg2ref { GetRegister32Bit(reg2, cpu.state) };
+        reg2ref += reg1ref;
+    }
 
-        return exc.GetCode();,
-        return Error::UnhandledException;
-    )
+    return System::ErrorCode::Ok;
 }
 
-OPR CPU::AddSafe32(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::AddSafe32(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        sysbit_t int1;
-        sysbit_t int2;
-        int1 = IntegerFromBytes<sysbit_t>(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data);
-        int2 = IntegerFromBytes<sysbit_t>(cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data);
-
-        char* data { BytesFromInteger(int1+int2) };
-        Error err { cpu.PushSome({
-            data,
-            4
-        })};
-        delete[] data;
-
-        return err;,
-
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    return cpu.Binary<sysbit_t, Safe, true>([](sysbit_t lhs, sysbit_t rhs) { return lhs+rhs; });
 }
 
-OPR CPU::AddSafeFloat(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::AddSafeFloat(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        float float1;
-        float float2;
-        float1 = FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data);
-        float2 = FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data);
-
-        char* data { BytesFromFloat<char>(float1+float2) };
-        Error err { cpu.PushSome({
-            data,
-            4
-        })};
-        delete[] data;
-
-        return err;,
-
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    return cpu.Binary<float, Safe, true>([](float lhs, float rhs) { return lhs+rhs; });
 }
 
-OPR CPU::AddSafe8(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::AddSafe8(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        uchar_t byte1;
-        uchar_t byte2;
-        byte1 = cpu.board.ram.Read(cpu.state.sp-1);
-        byte2 = cpu.board.ram.Read(cpu.state.sp-2);
-        
-        Error err { cpu.Push(byte1+byte2) };
-        return err;,
-
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    return cpu.Binary<uchar_t, Safe, true>([](uchar_t lhs, uchar_t rhs) { return lhs+rhs; });
 }
 
-OPR CPU::MemCopy(CPU& cpu) noexcept
+OPR CPU::MemCopy(CPU& cpu, const Instruction& ins) noexcept
 {
     // mcp <4bits> <4bits>
     // bits are memory mode flags
-    try_catch(
-        uchar_t compressedModes { static_cast<uchar_t>(cpu.board.assembly.Rom().Read(cpu.state.pc)) };
-        MemoryModeFlags from { MemoryModeFlags(compressedModes >> 4) };
-        MemoryModeFlags to { MemoryModeFlags(compressedModes & 0x0F) };
+    uchar_t compressedModes { ins.mode };
+    MemoryModeFlags from { MemoryModeFlags(compressedModes >> 4) };
+    MemoryModeFlags to { MemoryModeFlags(compressedModes & 0x0F) };
 
-        sysbit_t fromAddr { GetRegister32Bit(RegisterModeFlags::eax, cpu.state) };
-        sysbit_t toAddr { GetRegister32Bit(RegisterModeFlags::ebx, cpu.state) };
-        sysbit_t size { GetRegister32Bit(RegisterModeFlags::ecx, cpu.state) };
+    sysbit_t fromAddr { GetRegister32Bit(RegisterModeFlags::eax, cpu.state) };
+    sysbit_t toAddr { GetRegister32Bit(RegisterModeFlags::ebx, cpu.state) };
+    sysbit_t size { GetRegister32Bit(RegisterModeFlags::ecx, cpu.state) };
 
-        // Disable stupid mode check
+    // Disable stupid mode check
 //        auto modeCheck = [&cpu](MemoryModeFlags flag, sysbit_t addr) -> bool {
 //            if (flag == MemoryModeFlags::Stack)
 //                return (addr < cpu.board.ram.StackSize());
@@ -517,1056 +474,696 @@ OPR CPU::MemCopy(CPU& cpu) noexcept
 //                "\nTo Flag: ", MemoryModeFlagsString(to), " To Addr: ", std::to_string(toAddr),
 //                "\n Heap Start: ", std::to_string(cpu.board.ram.StackSize())
 //            );
-        
-        if ((toAddr + size) > cpu.board.ram.Size())
-            CRASH(
-                System::ErrorCode::MemoryOverflow,
-                "In ", cpu.board.Stringify(), nameof(MemCopy), " instruction will cause memory overflow.",
-                "\nTo Address: ", std::to_string(toAddr), " Size: ", std::to_string(size),
-                "\nMemory Size: ", std::to_string(cpu.board.ram.Size())
-            );
-
-        if (to == MemoryModeFlags::Stack && (toAddr + size) >= cpu.board.ram.StackSize())
-            LOGW(
-                "In ", cpu.board.Stringify(), nameof(MemCopy), 
-                " instruction will overflow from stack and overwrite heap."
-            );
-
-        Slice dataToCopy { cpu.board.ram.ReadSome(fromAddr, size) };
-        Error code { cpu.board.ram.WriteSome(toAddr, dataToCopy) };
-
-        if (code == System::ErrorCode::Ok)
-            cpu.state.pc++;
+    
+    if (!cpu.board.ram.Contains(toAddr, size))
+    {
+        LOGE(
+            System::LogLevel::Medium,
+            "In ", cpu.board.Stringify(), nameof(MemCopy), " instruction will cause memory overflow.",
+            "\nTo Address: ", std::to_string(toAddr), " Size: ", std::to_string(size),
+            "\nMemory Size: ", std::to_string(cpu.board.ram.Size())
+        );
+        return System::ErrorCode::MemoryOverflow;
+    }
 
-        return code;,
+    if (to == MemoryModeFlags::Stack && (toAddr + size) >= cpu.board.ram.StackSize())
+        LOGW(
+            "In ", cpu.board.Stringify(), nameof(MemCopy), 
+            " instruction will overflow from stack and overwrite heap."
+        );
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    return cpu.board.ram.Copy(toAddr, fromAddr, size);
 }
 
-OPR CPU::Increment(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::Increment(CPU& cpu, const Instruction& ins) noexcept
 {
     // inc[type] <value> 
-    try_catch(
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1)))
+    switch (ins.op)
+    {
+        case OpCodes::inci:
         {
-            case OpCodes::inci:
+            if (Safe && cpu.state.sp < 4)
             {
-                if (cpu.state.sp < 4)
-                    CRASH(
-                        System::ErrorCode::Bad,
-                        "In ", cpu.board.Stringify(), nameof(Increment),
-                        "can't increment (u)int from stack, SP < 4."
-                    );
-
-                sysbit_t amount { IntegerFromBytes<sysbit_t>(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data 
-                )};
-
-                sysbit_t stack { IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data
-                )};
-
-                char* data { BytesFromInteger(stack+amount) };
-                Error code { cpu.board.ram.WriteSome(
-                    cpu.state.sp-4,
-                    {data, 4}
-                )};
-                delete[] data;
-
-                if (code == System::ErrorCode::Ok)
-                    cpu.state.pc+=4;
-
-                return code;
+                LOGE(
+                    System::LogLevel::Medium,
+                    "In ", cpu.board.Stringify(), nameof(Increment),
+                    "can't increment (u)int from stack, SP < 4."
+                );
+                return System::ErrorCode::Bad;
             }
 
-            case OpCodes::incf:
+            sysbit_t amount { ins.imm };
+
+            return cpu.Unary<sysbit_t, Safe>([amount](sysbit_t stack) { return stack + amount; });
+        }
+
+        case OpCodes::incf:
+        {
+            if (Safe && cpu.state.sp < 4)
             {
-                if (cpu.state.sp < 4)
-                    CRASH(
-                        System::ErrorCode::Bad,
-                        "In ", cpu.board.Stringify(), nameof(Increment),
-                        "can't increment (u)int from stack, SP < 4."
-                    );
-
-                float amount { FloatFromBytes(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data
-                )}; 
-
-                float stack { FloatFromBytes(
-                    cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data      
-                )};
-
-                char* data { BytesFromFloat(amount+stack) };
-                Error code { cpu.board.ram.WriteSome(
-                    cpu.state.sp-4,
-                    {data, 4}
-                )};
-                delete[] data;
-
-                if (code == System::ErrorCode::Ok)
-                    cpu.state.pc+=4;
-
-                return code;
+                LOGE(
+                    System::LogLevel::Medium,
+                    "In ", cpu.board.Stringify(), nameof(Increment),
+                    "can't increment (u)int from stack, SP < 4."
+                );
+                return System::ErrorCode::Bad;
             }
 
-            case OpCodes::incb:
+            float amount { std::bit_cast<float>(ins.imm)}; 
+
+            return cpu.Unary<float, Safe>([amount](float stack) { return stack + amount; });
+        }
+
+        case OpCodes::incb:
+        {
+            if (Safe && cpu.state.sp < 1)
             {
-                if (cpu.state.sp < 1)
-                    CRASH(
-                        System::ErrorCode::Bad,
-                        "In ", cpu.board.Stringify(), nameof(Increment),
-                        "can't increment (u)int from stack, SP < 4."
-                    );
-
-                uchar_t amount { static_cast<uchar_t>(
-                    cpu.board.assembly.Rom().Read(cpu.state.pc)
-                )};
-                uchar_t stack { static_cast<uchar_t>(
-                    cpu.board.ram.Read(cpu.state.sp-1)
-                )};
-
-                Error code { cpu.board.ram.Write(
-                    cpu.state.sp-1,
-                    amount + stack
-                )};
-
-                if (code == System::ErrorCode::Ok)
-                    cpu.state.pc++;
-
-                return code;
+                LOGE(
+                    System::LogLevel::Medium,
+                    "In ", cpu.board.Stringify(), nameof(Increment),
+                    "can't increment (u)int from stack, SP < 4."
+                );
+                return System::ErrorCode::Bad;
             }
 
-            default:
-                return Error::InvalidInstruction;        
+            uchar_t amount { static_cast<uchar_t>(ins.imm) };
+
+            return cpu.Unary<uchar_t, Safe>([amount](uchar_t stack) { return stack + amount; });
         }
 
-        return System::ErrorCode::Ok;,
+        default:
+            return Error::InvalidInstruction;        
+    }
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    return System::ErrorCode::Ok;
 }
 
-OPR CPU::IncrementReg(CPU& cpu) noexcept
+OPR CPU::IncrementReg(CPU& cpu, const Instruction& ins) noexcept
 {
     // incr[type] <value> 
     // register size checks are done at assemble-time
-    try_catch(
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1)))
+    switch (ins.op)
+    {
+        case OpCodes::incri:
         {
-            case OpCodes::incri:
-            {
-                sysbit_t& reg { GetRegister32Bit(
-                    RegisterModeFlags(cpu.board.assembly.Rom().Read(cpu.state.pc)),
-                    cpu.state
-                )};
-
-                sysbit_t amount { IntegerFromBytes<sysbit_t>(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc+1, 4).data
-                )};
+            sysbit_t& reg { GetRegister32Bit(
+                RegisterModeFlags(ins.reg1),
+                cpu.state
+            )};
 
-                reg += amount;
+            sysbit_t amount { ins.imm };
 
-                cpu.state.pc+=5;
+            reg += amount;
 
-                return System::ErrorCode::Ok;
-            }
 
-            case OpCodes::incrf:
-            {
-                sysbit_t& reg { GetRegister32Bit(
-                    RegisterModeFlags(cpu.board.assembly.Rom().Read(cpu.state.pc)),
-                    cpu.state
-                )};
+            return System::ErrorCode::Ok;
+        }
 
-                char* data { BytesFromInteger(reg) };
-                float regVal { FloatFromBytes(data)}; 
-                delete[] data;
+        case OpCodes::incrf:
+        {
+            sysbit_t& reg { GetRegister32Bit(
+                RegisterModeFlags(ins.reg1),
+                cpu.state
+            )};
 
-                float amount { FloatFromBytes(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc+1, 4).data      
-                )};
+            float regVal { std::bit_cast<float>(reg)}; 
 
-                data = BytesFromFloat(regVal+amount);
-                reg = IntegerFromBytes<sysbit_t>(data);
-                delete[] data;
+            float amount { std::bit_cast<float>(ins.imm)};
 
-                cpu.state.pc+=5;
-                return System::ErrorCode::Ok;
-            }
+            reg = std::bit_cast<sysbit_t>(regVal+amount);
 
-            case OpCodes::incrb:
-            {
-                uchar_t& reg { GetRegister8Bit(
-                    RegisterModeFlags(cpu.board.assembly.Rom().Read(cpu.state.pc)),
-                    cpu.state
-                )};
+            return System::ErrorCode::Ok;
+        }
 
-                uchar_t amount { static_cast<uchar_t>(
-                    cpu.board.assembly.Rom().Read(cpu.state.pc+1)
-                )};
+        case OpCodes::incrb:
+        {
+            uchar_t& reg { GetRegister8Bit(
+                RegisterModeFlags(ins.reg1),
+                cpu.state
+            )};
 
-                reg += amount;
+            uchar_t amount { static_cast<uchar_t>(ins.imm) };
 
-                cpu.state.pc+=2;
-                return System::ErrorCode::Ok;
-            }
+            reg += amount;
 
-            default:
-                return Error::InvalidInstruction;        
-        },
+            return System::ErrorCode::Ok;
+        }
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+        default:
+            return Error::InvalidInstruction;        
+    }
 }
 
-OPR CPU::IncrementSafe(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::IncrementSafe(CPU& cpu, const Instruction& ins) noexcept
 {
     // inc[type] <value> 
-    try_catch(
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1)))
+    switch (ins.op)
+    {
+        case OpCodes::incsi:
         {
-            case OpCodes::incsi:
-            {
-                if (cpu.state.sp < 4)
-                    CRASH(
-                        System::ErrorCode::Bad,
-                        "In ", cpu.board.Stringify(), nameof(Increment),
-                        "can't increment (u)int from stack, SP < 4."
-                    );
-
-                sysbit_t amount { IntegerFromBytes<sysbit_t>(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data 
-                )};
-
-                sysbit_t stack { IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data
-                )};
-
-                char* data { BytesFromInteger(stack+amount) };
-                Error code { cpu.PushSome({
-                    data, 
-                    4
-                })};
-                delete[] data;
-
-                if (code == System::ErrorCode::Ok)
-                    cpu.state.pc+=4;
-
-                return code;
-            }
-
-            case OpCodes::incsf:
+            if (Safe && cpu.state.sp < 4)
             {
-                if (cpu.state.sp < 4)
-                    CRASH(
-                        System::ErrorCode::Bad,
-                        "In ", cpu.board.Stringify(), nameof(Increment),
-                        "can't increment (u)int from stack, SP < 4."
-                    );
-
-                float amount { FloatFromBytes(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data
-                )}; 
-
-                float stack { FloatFromBytes(
-                    cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data      
-                )};
-
-                char* data { BytesFromFloat(amount+stack) };
-                Error code { cpu.PushSome({
-                    data,
-                    4
-                })};
-                delete[] data;
-
-                if (code == System::ErrorCode::Ok)
-                    cpu.state.pc+=4;
-
-                return code;
+                LOGE(
+                    System::LogLevel::Medium,
+                    "In ", cpu.board.Stringify(), nameof(Increment),
+                    "can't increment (u)int from stack, SP < 4."
+                );
+                return System::ErrorCode::Bad;
             }
 
-            case OpCodes::incsb:
-            {
-                if (cpu.state.sp < 1)
-                    CRASH(
-                        System::ErrorCode::Bad,
-                        "In ", cpu.board.Stringify(), nameof(Increment),
-                        "can't increment (u)int from stack, SP < 4."
-                    );
-
-                uchar_t amount { static_cast<uchar_t>(
-                    cpu.board.assembly.Rom().Read(cpu.state.pc)
-                )};
-                uchar_t stack { static_cast<uchar_t>(
-                    cpu.board.ram.Read(cpu.state.sp-1)
-                )};
-
-                Error code { cpu.Push(
-                    amount + stack
-                )};
-
-                if (code == System::ErrorCode::Ok)
-                    cpu.state.pc++;
-
-                return code;
-            }
+            sysbit_t amount { ins.imm };
 
-            default:
-                return Error::InvalidInstruction;        
+            return cpu.Unary<sysbit_t, Safe, true>([amount](sysbit_t stack) { return stack + amount; });
         }
 
-        return System::ErrorCode::Ok;,
-
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    ) 
-}
-
-OPR CPU::Decrement(CPU& cpu) noexcept
-{
-    try_catch(
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1)))
+        case OpCodes::incsf:
         {
-            case OpCodes::dcri:
+            if (Safe && cpu.state.sp < 4)
             {
-                if (cpu.state.sp < 4)
-                    CRASH(
-                        System::ErrorCode::Bad,
-                        "In ", cpu.board.Stringify(), nameof(Decrement),
-                        "can't decrement (u)int from stack, SP < 4."
-                    );
-
-                sysbit_t amount { IntegerFromBytes<sysbit_t>(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data 
-                )};
-
-                sysbit_t stack { IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data
-                )};
-
-                char* data { BytesFromInteger(stack - amount) };
-                Error code { cpu.board.ram.WriteSome(
-                    cpu.state.sp-4,
-                    {data, 4}
-                )};
-                delete[] data;
-
-                if (code == System::ErrorCode::Ok)
-                    cpu.state.pc+=4;
-
-                return code;
+                LOGE(
+                    System::LogLevel::Medium,
+                    "In ", cpu.board.Stringify(), nameof(Increment),
+                    "can't increment (u)int from stack, SP < 4."
+                );
+                return System::ErrorCode::Bad;
             }
 
-            case OpCodes::dcrf:
-            {
-                if (cpu.state.sp < 4)
-                    CRASH(
-                        System::ErrorCode::Bad,
-                        "In ", cpu.board.Stringify(), nameof(Decrement),
-                        "can't decrement float from stack, SP < 4."
-                    );
-
-                float amount { FloatFromBytes(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data
-                )}; 
-
-                float stack { FloatFromBytes(
-                    cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data      
-                )};
-
-                char* data { BytesFromFloat(stack - amount) };
-                Error code { cpu.board.ram.WriteSome(
-                    cpu.state.sp-4,
-                    {data, 4}
-                )};
-                delete[] data;
-
-                if (code == System::ErrorCode::Ok)
-                    cpu.state.pc+=4;
-
-                return code;
-            }
+            float amount { std::bit_cast<float>(ins.imm)}; 
+
+            return cpu.Unary<float, Safe, true>([amount](float stack) { return stack + amount; });
+        }
 
-            case OpCodes::dcrb:
+        case OpCodes::incsb:
+        {
+            if (Safe && cpu.state.sp < 1)
             {
-                if (cpu.state.sp < 1)
-                    CRASH(
-                        System::ErrorCode::Bad,
-                        "In ", cpu.board.Stringify(), nameof(Decrement),
-                        "can't decrement (u)byte from stack, SP < 4."
-                    );
-
-                uchar_t amount { static_cast<uchar_t>(
-                    cpu.board.assembly.Rom().Read(cpu.state.pc)
-                )};
-                uchar_t stack { static_cast<uchar_t>(
-                    cpu.board.ram.Read(cpu.state.sp-1)
-                )};
-
-                Error code { cpu.board.ram.Write(
-                    cpu.state.sp-1,
-                    stack - amount
-                )};
-
-                if (code == System::ErrorCode::Ok)
-                    cpu.state.pc++;
-
-                return code;
+                LOGE(
+                    System::LogLevel::Medium,
+                    "In ", cpu.board.Stringify(), nameof(Increment),
+                    "can't increment (u)int from stack, SP < 4."
+                );
+                return System::ErrorCode::Bad;
             }
 
-            default:
-                return Error::InvalidInstruction;        
+            uchar_t amount { static_cast<uchar_t>(ins.imm) };
+
+            return cpu.Unary<uchar_t, Safe, true>([amount](uchar_t stack) { return stack + amount; });
         }
 
-        return System::ErrorCode::Ok;,
+        default:
+            return Error::InvalidInstruction;        
+    }
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    return System::ErrorCode::Ok;
 }
 
-OPR CPU::DecrementReg(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::Decrement(CPU& cpu, const Instruction& ins) noexcept
 {
-    // register size checks are done at assemble-time
-    try_catch(
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1)))
+    switch (ins.op)
+    {
+        case OpCodes::dcri:
         {
-            case OpCodes::dcrri:
+            if (Safe && cpu.state.sp < 4)
             {
-                sysbit_t& reg { GetRegister32Bit(
-                    RegisterModeFlags(cpu.board.assembly.Rom().Read(cpu.state.pc)),
-                    cpu.state
-                )};
-
-                sysbit_t amount { IntegerFromBytes<sysbit_t>(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc+1, 4).data
-                )};
+                LOGE(
+                    System::LogLevel::Medium,
+                    "In ", cpu.board.Stringify(), nameof(Decrement),
+                    "can't decrement (u)int from stack, SP < 4."
+                );
+                return System::ErrorCode::Bad;
+            }
 
-                reg -= amount;
+            sysbit_t amount { ins.imm };
 
-                cpu.state.pc+=5;
+            return cpu.Unary<sysbit_t, Safe>([amount](sysbit_t stack) { return stack - amount; });
+        }
 
-                return System::ErrorCode::Ok;
-            }
+        case OpCodes::dcrf:
+        {
+            if (Safe && cpu.state.sp < 4)
+            {
+                LOGE(
+                    System::LogLevel::Medium,
+                    "In ", cpu.board.Stringify(), nameof(Decrement),
+                    "can't decrement float from stack, SP < 4."
+                );
+                return System::ErrorCode::Bad;
+            }
+
+            float amount { std::bit_cast<float>(ins.imm)}; 
+
+            return cpu.Unary<float, Safe>([amount](float stack) { return stack - amount; });
+        }
 
-            case OpCodes::dcrrf:
+        case OpCodes::dcrb:
+        {
+            if (Safe && cpu.state.sp < 1)
             {
-                sysbit_t& reg { GetRegister32Bit(
-                    RegisterModeFlags(cpu.board.assembly.Rom().Read(cpu.state.pc)),
-                    cpu.state
-                )};
+                LOGE(
+                    System::LogLevel::Medium,
+                    "In ", cpu.board.Stringify(), nameof(Decrement),
+                    "can't decrement (u)byte from stack, SP < 4."
+                );
+                return System::ErrorCode::Bad;
+            }
 
-                char* data { BytesFromInteger(reg) };
-                float regVal { FloatFromBytes(data)}; 
-                delete[] data;
+            uchar_t amount { static_cast<uchar_t>(ins.imm) };
+
+            return cpu.Unary<uchar_t, Safe>([amount](uchar_t stack) { return stack - amount; });
+        }
 
-                float amount { FloatFromBytes(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc+1, 4).data      
-                )};
+        default:
+            return Error::InvalidInstruction;        
+    }
 
-                data = BytesFromFloat(regVal - amount);
-                reg = IntegerFromBytes<sysbit_t>(data);
-                delete[] data;
+    return System::ErrorCode::Ok;
+}
 
-                cpu.state.pc+=5;
-                return System::ErrorCode::Ok;
-            }
+OPR CPU::DecrementReg(CPU& cpu, const Instruction& ins) noexcept
+{
+    // register size checks are done at assemble-time
+    switch (ins.op)
+    {
+        case OpCodes::dcrri:
+        {
+            sysbit_t& reg { GetRegister32Bit(
+                RegisterModeFlags(ins.reg1),
+                cpu.state
+            )};
 
-            case OpCodes::dcrrb:
-            {
-                uchar_t& reg { GetRegister8Bit(
-                    RegisterModeFlags(cpu.board.assembly.Rom().Read(cpu.state.pc)),
-                    cpu.state
-                )};
+            sysbit_t amount { ins.imm };
 
-                uchar_t amount { static_cast<uchar_t>(
-                    cpu.board.assembly.Rom().Read(cpu.state.pc+1)
-                )};
+            reg -= amount;
 
-                reg -= amount;
 
-                cpu.state.pc+=2;
-                return System::ErrorCode::Ok;
-            }
+            return System::ErrorCode::Ok;
+        }
+
+        case OpCodes::dcrrf:
+        {
+            sysbit_t& reg { GetRegister32Bit(
+                RegisterModeFlags(ins.reg1),
+                cpu.state
+            )};
 
-            default:
-                return Error::InvalidInstruction;        
-        },
+            float regVal { std::bit_cast<float>(reg)}; 
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+            float amount { std::bit_cast<float>(ins.imm)};
+
+            reg = std::bit_cast<sysbit_t>(regVal - amount);
+
+            return System::ErrorCode::Ok;
+        }
+
+        case OpCodes::dcrrb:
+        {
+            uchar_t& reg { GetRegister8Bit(
+                RegisterModeFlags(ins.reg1),
+                cpu.state
+            )};
+
+            uchar_t amount { static_cast<uchar_t>(ins.imm) };
+
+            reg -= amount;
+
+            return System::ErrorCode::Ok;
+        }
+
+        default:
+            return Error::InvalidInstruction;        
+    }
 }
 
-OPR CPU::DecrementSafe(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::DecrementSafe(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1)))
+    switch (ins.op)
+    {
+        case OpCodes::dcrsi:
         {
-            case OpCodes::dcrsi:
+            if (Safe && cpu.state.sp < 4)
             {
-                if (cpu.state.sp < 4)
-                    CRASH(
-                        System::ErrorCode::Bad,
-                        "In ", cpu.board.Stringify(), nameof(Decrement),
-                        "can't decrement (u)int from stack, SP < 4."
-                    );
-
-                sysbit_t amount { IntegerFromBytes<sysbit_t>(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data 
-                )};
-
-                sysbit_t stack { IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data
-                )} ;
-
-                char* data { BytesFromInteger(stack - amount) };
-                Error code { cpu.PushSome({
-                    data, 
-                    4
-                })};
-                delete[] data;
-
-                if (code == System::ErrorCode::Ok)
-                    cpu.state.pc+=4;
-
-                return code;
+                LOGE(
+                    System::LogLevel::Medium,
+                    "In ", cpu.board.Stringify(), nameof(Decrement),
+                    "can't decrement (u)int from stack, SP < 4."
+                );
+                return System::ErrorCode::Bad;
             }
 
-            case OpCodes::dcrsf:
+            sysbit_t amount { ins.imm };
+
+            return cpu.Unary<sysbit_t, Safe, true>([amount](sysbit_t stack) { return stack - amount; });
+        }
+
+        case OpCodes::dcrsf:
+        {
+            if (Safe && cpu.state.sp < 4)
             {
-                if (cpu.state.sp < 4)
-                    CRASH(
-                        System::ErrorCode::Bad,
-                        "In ", cpu.board.Stringify(), nameof(Decrement),
-                        "can't decrement (u)int from stack, SP < 4."
-                    );
-
-                float amount { FloatFromBytes(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data
-                )}; 
-
-                float stack { FloatFromBytes(
-                    cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data      
-                )};
-
-                char* data { BytesFromFloat(stack - amount) };
-                Error code { cpu.PushSome({
-                    data,
-                    4
-                })};
-                delete[] data;
-
-                if (code == System::ErrorCode::Ok)
-                    cpu.state.pc+=4;
-
-                return code;
+                LOGE(
+                    System::LogLevel::Medium,
+                    "In ", cpu.board.Stringify(), nameof(Decrement),
+                    "can't decrement (u)int from stack, SP < 4."
+                );
+                return System::ErrorCode::Bad;
             }
 
-            case OpCodes::dcrsb:
+            float amount { std::bit_cast<float>(ins.imm)}; 
+
+            return cpu.Unary<float, Safe, true>([amount](float stack) { return stack - amount; });
+        }
+
+        case OpCodes::dcrsb:
+        {
+            if (Safe && cpu.state.sp < 1)
             {
-                if (cpu.state.sp < 1)
-                    CRASH(
-                        System::ErrorCode::Bad,
-                        "In ", cpu.board.Stringify(), nameof(Decrement),
-                        "can't decrement (u)int from stack, SP < 4."
-                    );
-
-                uchar_t amount { static_cast<uchar_t>(
-                    cpu.board.assembly.Rom().Read(cpu.state.pc)
-                )};
-                uchar_t stack { static_cast<uchar_t>(
-                    cpu.board.ram.Read(cpu.state.sp-1)
-                )};
-
-                Error code { cpu.Push(
-                    stack - amount 
-                )};
-
-                if (code == System::ErrorCode::Ok)
-                    cpu.state.pc++;
-
-                return code;
+                LOGE(
+                    System::LogLevel::Medium,
+                    "In ", cpu.board.Stringify(), nameof(Decrement),
+                    "can't decrement (u)int from stack, SP < 4."
+                );
+                return System::ErrorCode::Bad;
             }
 
-            default:
-                return Error::InvalidInstruction;        
+            uchar_t amount { static_cast<uchar_t>(ins.imm) };
+
+            return cpu.Unary<uchar_t, Safe, true>([amount](uchar_t stack) { return stack - amount; });
         }
 
-        return System::ErrorCode::Ok;,
+        default:
+            return Error::InvalidInstruction;        
+    }
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    ) 
+    return System::ErrorCode::Ok;
 }
 
 #define arr std::array
 #define fn std::function<sysbit_t(sysbit_t, sysbit_t)>
-OPR CPU::BitLogic(CPU& cpu, arr<OpCodes, 3> op, fn bitwise) noexcept
+OPR CPU::BitLogic(CPU& cpu, const Instruction& ins, arr<OpCodes, 3> op, fn bitwise) noexcept
 {
-    try_catch(
-        OpCodes opc { cpu.board.assembly.Rom().Read(cpu.state.pc-1) };
-        if (opc == op.at(0))
+    OpCodes opc { ins.op };
+    if (opc == op.at(0))
+    {
+        sysbit_t val1, val2;
+        if (Error err { cpu.PeekU32(val1, 8) }; err != System::ErrorCode::Ok)
+            return err;
+        cpu.PeekU32(val2, 4);
+        
+        if (Is8BitReg(ins.reg1))
         {
-            sysbit_t val1 { IntegerFromBytes<sysbit_t>(
-                cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data
+            uchar_t& reg { GetRegister8Bit(
+                RegisterModeFlags(ins.reg1),
+                cpu.state
             )};
-
-            sysbit_t val2 { IntegerFromBytes<sysbit_t>(
-                cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data
-            )}; 
-            
-            if (Is8BitReg(cpu.board.assembly.Rom().Read(cpu.state.pc)))
-            {
-                uchar_t& reg { GetRegister8Bit(
-                    RegisterModeFlags(cpu.board.assembly.Rom().Read(cpu.state.pc)),
-                    cpu.state
-                )};
-                reg = static_cast<uchar_t>(bitwise(val1, val2));
-            }
-            else
-            {
-                sysbit_t& reg { GetRegister32Bit(
-                    RegisterModeFlags(cpu.board.assembly.Rom().Read(cpu.state.pc)),
-                    cpu.state
-                )};
-                reg = bitwise(val1, val2);
-            }
-
-            cpu.state.pc++; 
-            return System::ErrorCode::Ok;
+            reg = static_cast<uchar_t>(bitwise(val1, val2));
         }
-        if (opc == op.at(1))
+        else
         {
-            uchar_t val1 { 
-                static_cast<uchar_t>(cpu.board.ram.Read(cpu.state.sp-2))
-            };
-
-            uchar_t val2 {
-                static_cast<uchar_t>(cpu.board.ram.Read(cpu.state.sp-1))
-            };
-        
-            if (Is8BitReg(cpu.board.assembly.Rom().Read(cpu.state.pc)))
-            {
-                uchar_t& reg { GetRegister8Bit(
-                    RegisterModeFlags(cpu.board.assembly.Rom().Read(cpu.state.pc)),
-                    cpu.state
-                )};
-                reg = static_cast<uchar_t>(bitwise(val1, val2));
-            }
-            else
-            {
-                sysbit_t& reg { GetRegister32Bit(
-                    RegisterModeFlags(cpu.board.assembly.Rom().Read(cpu.state.pc)),
-                    cpu.state
-                )};
-                reg = bitwise(val1, val2);
-            }
+            sysbit_t& reg { GetRegister32Bit(
+                RegisterModeFlags(ins.reg1),
+                cpu.state
+            )};
+            reg = bitwise(val1, val2);
+        }
 
-            cpu.state.pc++; 
-            return System::ErrorCode::Ok;
+        return System::ErrorCode::Ok;
+    }
+    if (opc == op.at(1))
+    {
+        uchar_t val1, val2;
+        if (Error err { cpu.PeekU8(val1, 2) }; err != System::ErrorCode::Ok)
+            return err;
+        cpu.PeekU8(val2, 1);
+    
+        if (Is8BitReg(ins.reg1))
+        {
+            uchar_t& reg { GetRegister8Bit(
+                RegisterModeFlags(ins.reg1),
+                cpu.state
+            )};
+            reg = static_cast<uchar_t>(bitwise(val1, val2));
         }
-        if (opc == op.at(2))
+        else
         {
-            RegisterModeFlags reg1mode {
-                cpu.board.assembly.Rom().Read(cpu.state.pc)
-            };
-
-            RegisterModeFlags reg2mode {
-                cpu.board.assembly.Rom().Read(cpu.state.pc+1)
-            };
-
-            sysbit_t reg1;
-            if (Is8BitReg(reg1mode))
-                reg1 = static_cast<sysbit_t>(GetRegister8Bit(reg1mode, cpu.state));
-            else 
-                reg1 = GetRegister32Bit(reg1mode, cpu.state);
-
-            if (Is8BitReg(reg2mode))
-                GetRegister8Bit(reg2mode, cpu.state) = 
-                    bitwise(GetRegister8Bit(reg2mode, cpu.state), static_cast<uchar_t>(reg1));
-            else
-                GetRegister32Bit(reg2mode, cpu.state) = 
-                    bitwise(GetRegister32Bit(reg2mode, cpu.state), static_cast<uchar_t>(reg1));
-
-            cpu.state.pc+=2; 
-            return System::ErrorCode::Ok;
+            sysbit_t& reg { GetRegister32Bit(
+                RegisterModeFlags(ins.reg1),
+                cpu.state
+            )};
+            reg = bitwise(val1, val2);
         }
-        return System::ErrorCode::InvalidSpecifier;,
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+        return System::ErrorCode::Ok;
+    }
+    if (opc == op.at(2))
+    {
+        RegisterModeFlags reg1mode { ins.reg1 };
+        RegisterModeFlags reg2mode { ins.reg2 };
+
+        sysbit_t reg1;
+        if (Is8BitReg(reg1mode))
+            reg1 = static_cast<sysbit_t>(GetRegister8Bit(reg1mode, cpu.state));
+        else 
+            reg1 = GetRegister32Bit(reg1mode, cpu.state);
+
+        if (Is8BitReg(reg2mode))
+            GetRegister8Bit(reg2mode, cpu.state) = 
+                bitwise(GetRegister8Bit(reg2mode, cpu.state), static_cast<uchar_t>(reg1));
+        else
+            GetRegister32Bit(reg2mode, cpu.state) = 
+                bitwise(GetRegister32Bit(reg2mode, cpu.state), static_cast<uchar_t>(reg1));
+
+        return System::ErrorCode::Ok;
+    }
+    return System::ErrorCode::InvalidSpecifier;
 }
 #undef arr
 #undef fn
 
-OPR CPU::BitAnd(CPU& cpu) noexcept
+OPR CPU::BitAnd(CPU& cpu, const Instruction& ins) noexcept
 {
     return BitLogic(
-        cpu, 
+        cpu, ins,
         {OpCodes::andst, OpCodes::andse, OpCodes::andr},
         [](sysbit_t a, sysbit_t b) -> sysbit_t { return a & b; }
     ); 
 }
 
-OPR CPU::BitOr(CPU& cpu) noexcept
+OPR CPU::BitOr(CPU& cpu, const Instruction& ins) noexcept
 {
     return BitLogic(
-        cpu, 
+        cpu, ins,
         {OpCodes::orst, OpCodes::orse, OpCodes::orr},
         [](sysbit_t a, sysbit_t b) -> sysbit_t { return a | b; }
     );
 }
 
-OPR CPU::BitNor(CPU& cpu) noexcept
+OPR CPU::BitNor(CPU& cpu, const Instruction& ins) noexcept
 {
     LOGW("This operation ", nameof(BitNor), " is stupid as hell. Why does it exist?");
     return BitLogic(
-        cpu,
+        cpu, ins,
         {OpCodes::norst, OpCodes::norse, OpCodes::norr},
         [](sysbit_t a, sysbit_t b) -> sysbit_t { return ~(a | b);}
     );
 }
 
-OPR CPU::SwapTop(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::SwapTop(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1)))
+    switch (ins.op)
+    {
+        case OpCodes::swpt:
         {
-            case OpCodes::swpt:
-            {
-                if (cpu.state.sp < 8)
-                    CRASH(
-                        System::ErrorCode::RAMAccessError,
-                        "In ", cpu.board.Stringify(),
-                        " can't swap 32-bits on stack, SP < 8"
-                    );
-
-                sysbit_t bottom { IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data
-                )};
-
-                sysbit_t top { IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data
-                )};
-
-                {
-                    char* data { BytesFromInteger(top) };
-                    Error err { cpu.board.ram.WriteSome(
-                        cpu.state.sp-8,
-                        {data, 4} 
-                    )};
-                    delete[] data;
-
-                    if (err != System::ErrorCode::Ok)
-                        return err;
-                }
-
-                char* data { BytesFromInteger(bottom) };
-                Error err { cpu.board.ram.WriteSome(
-                    cpu.state.sp-4,
-                    {data, 4}
-                )};
-                delete[] data;
-
-                return err;
-            }
-
-            case OpCodes::swpe:
+            if (Safe && cpu.state.sp < 8)
             {
-                if (cpu.state.sp < 2)
-                    CRASH(
-                        System::ErrorCode::RAMAccessError,
-                        "In ", cpu.board.Stringify(),
-                        " can't swap 32-bits on stack, SP < 2"
-                    );
-
-                char bottom { 
-                    cpu.board.ram.Read(cpu.state.sp-2)
-                };
-
-                char top { 
-                    cpu.board.ram.Read(cpu.state.sp-1)
-                };
-
-                {
-                    Error err { cpu.board.ram.Write(
-                        cpu.state.sp-2,
-                        top 
-                    )};
-
-                    if (err != System::ErrorCode::Ok)
-                        return err;
-                }
-
-                Error err { cpu.board.ram.Write(
-                    cpu.state.sp-1,
-                    bottom
-                )};
-
-                return err;
-            }
-
-            case OpCodes::swpr:
-            { 
-                RegisterModeFlags reg1flag {
-                    cpu.board.assembly.Rom().Read(cpu.state.pc)
-                };
-
-                RegisterModeFlags reg2flag {
-                    cpu.board.assembly.Rom().Read(cpu.state.pc+1)
-                };
-
-                sysbit_t reg1;
-                sysbit_t reg2;
-                if (Is8BitReg(reg1flag))
-                    reg1 = static_cast<sysbit_t>(GetRegister8Bit(reg1flag, cpu.state));
-                else
-                    reg1 = GetRegister32Bit(reg1flag, cpu.state);
-                if (Is8BitReg(reg2flag))
-                    reg2 = static_cast<sysbit_t>(GetRegister8Bit(reg2flag, cpu.state));
-                else
-                    reg2 = GetRegister32Bit(reg2flag, cpu.state);
-
-                if (Is8BitReg(reg1flag))
-                    GetRegister8Bit(reg1flag, cpu.state) = static_cast<uchar_t>(reg2);
-                else
-                    GetRegister32Bit(reg1flag, cpu.state) = reg2;
-                if (Is8BitReg(reg2flag))
-                    GetRegister8Bit(reg2flag, cpu.state) = static_cast<uchar_t>(reg1);
-                else
-                    GetRegister32Bit(reg2flag, cpu.state) = reg1;
-
-                return System::ErrorCode::Ok;
+                LOGE(
+                    System::LogLevel::Medium,
+                    "In ", cpu.board.Stringify(),
+                    " can't swap 32-bits on stack, SP < 8"
+                );
+                return System::ErrorCode::RAMAccessError;
             }
 
-            default:
-                return System::ErrorCode::InvalidInstruction;
-        },
+            char* bottom { cpu.board.ram.At(cpu.state.sp-8) };
+            std::swap_ranges(bottom, bottom+4, bottom+4);
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
-}
+            return System::ErrorCode::Ok;
+        }
 
-OPR CPU::DuplicateTop(CPU& cpu) noexcept
-{
-    try_catch(
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1)))
+        case OpCodes::swpe:
         {
-            case OpCodes::dupt:
+            if (Safe && cpu.state.sp < 2)
             {
-                if (cpu.state.sp < 4)
-                    CRASH(
-                        Error::RAMAccessError,
-                        "In ", cpu.board.Stringify(),
-                        " can't duplicate 32-bits on stack. SP < 4"
-                    );
-
-                Slice data { cpu.board.ram.ReadSome(cpu.state.sp-4, 4) };
-                Error code { cpu.PushSome(data) };
-                
-                return code;
+                LOGE(
+                    System::LogLevel::Medium,
+                    "In ", cpu.board.Stringify(),
+                    " can't swap 32-bits on stack, SP < 2"
+                );
+                return System::ErrorCode::RAMAccessError;
             }
 
-            case OpCodes::dupe:
-            {
-                if (cpu.state.sp < 1)
-                    CRASH(
-                        Error::RAMAccessError,
-                        "In ", cpu.board.Stringify(),
-                        " can't duplicate 8-bits on stack. SP < 1"
-                    );
+            char* bottom { cpu.board.ram.At(cpu.state.sp-2) };
+            std::swap(bottom[0], bottom[1]);
+
+            return System::ErrorCode::Ok;
+        }
 
-                const char data { cpu.board.ram.Read(cpu.state.sp-1) };
-                Error code { cpu.Push(data) };
+        case OpCodes::swpr:
+        { 
+            RegisterModeFlags reg1flag { ins.reg1 };
+            RegisterModeFlags reg2flag { ins.reg2 };
 
-                return code;
-            }
-            break;
+            sysbit_t reg1;
+            sysbit_t reg2;
+            if (Is8BitReg(reg1flag))
+                reg1 = static_cast<sysbit_t>(GetRegister8Bit(reg1flag, cpu.state));
+            else
+                reg1 = GetRegister32Bit(reg1flag, cpu.state);
+            if (Is8BitReg(reg2flag))
+                reg2 = static_cast<sysbit_t>(GetRegister8Bit(reg2flag, cpu.state));
+            else
+                reg2 = GetRegister32Bit(reg2flag, cpu.state);
+
+            if (Is8BitReg(reg1flag))
+                GetRegister8Bit(reg1flag, cpu.state) = static_cast<uchar_t>(reg2);
+            else
+                GetRegister32Bit(reg1flag, cpu.state) = reg2;
+            if (Is8BitReg(reg2flag))
+                GetRegister8Bit(reg2flag, cpu.state) = static_cast<uchar_t>(reg1);
+            else
+                GetRegister32Bit(reg2flag, cpu.state) = reg1;
 
-            default:
-                return System::ErrorCode::InvalidInstruction;
-        },
+            return System::ErrorCode::Ok;
+        }
 
-        return exc.GetCode();,
-        return Error::UnhandledException;
-    );
+        default:
+            return System::ErrorCode::InvalidInstruction;
+    }
 }
 
-OPR CPU::RawDataStack(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::DuplicateTop(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1)))
+    switch (ins.op)
+    {
+        case OpCodes::dupt:
         {
-            case OpCodes::raw:
+            if (Safe && cpu.state.sp < 4)
             {
-                // raw <size> <..data..>
-                sysbit_t size { IntegerFromBytes<sysbit_t>(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data
-                )};
-                cpu.state.pc += 4;
-
-                System::ErrorCode err;
-                for (; size > 0; size--)
-                {
-                    err = cpu.Push(
-                        cpu.board.assembly.Rom().Read(cpu.state.pc++)
-                    );
-
-                    if (err != System::ErrorCode::Ok)
-                        break;
-                }
-
-                return err;
+                LOGE(
+                    System::LogLevel::Medium,
+                    "In ", cpu.board.Stringify(),
+                    " can't duplicate 32-bits on stack. SP < 4"
+                );
+                return Error::RAMAccessError;
             }
 
-            case OpCodes::raws:
+            return cpu.Unary<sysbit_t, Safe, true>([](sysbit_t top) { return top; });
+        }
+
+        case OpCodes::dupe:
+        {
+            if (Safe && cpu.state.sp < 1)
             {
-                // raw <address> <size> 
-                sysbit_t addr { IntegerFromBytes<sysbit_t>(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data
-                )};
-                cpu.state.pc += 4;
-
-                sysbit_t size { IntegerFromBytes<sysbit_t>(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data
-                )};
-                cpu.state.pc += 4;
-
-                return cpu.PushSome(
-                    cpu.board.assembly.Rom().ReadSome(addr, size)
+                LOGE(
+                    System::LogLevel::Medium,
+                    "In ", cpu.board.Stringify(),
+                    " can't duplicate 8-bits on stack. SP < 1"
                 );
+                return Error::RAMAccessError;
             }
 
-            default:
-                return System::ErrorCode::InvalidInstruction;
-        }, 
+            return cpu.Unary<uchar_t, Safe, true>([](uchar_t top) { return top; });
+        }
+        break;
 
-        return exc.GetCode();, 
-        return Error::UnhandledException;
-    )
+        default:
+            return System::ErrorCode::InvalidInstruction;
+    }
 }
 
-OPR CPU::Invert(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::RawDataStack(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1)))
+    switch (ins.op)
+    {
+        case OpCodes::raw:
         {
-            case OpCodes::invt:
-            {
-                sysbit_t top32 { IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data 
-                )};
-                System::ErrorCode err { cpu.PopSome(4) };
+            // raw <size> <..data..>
+            return cpu.PushSome<Safe>({ ins.data, ins.imm });
+        }
 
-                if (err != System::ErrorCode::Ok)
-                    return err;
+        case OpCodes::raws:
+        {
+            // raw <address> <size> 
+            // range was checked when decoded
+            return cpu.PushSome<Safe>({ ins.data, ins.imm2 });
+        }
 
-                top32 = ~top32;
+        default:
+            return System::ErrorCode::InvalidInstruction;
+    }
+}
 
-                char* data { BytesFromInteger(
-                    top32
-                )};
+template<bool Safe>
+OPR CPU::Invert(CPU& cpu, const Instruction& ins) noexcept
+{
+    switch (ins.op)
+    {
+        case OpCodes::invt:
+        {
+            return cpu.Unary<sysbit_t, Safe>([](sysbit_t top) { return ~top; });
+        }
 
-                err = cpu.PushSome({
-                    data,
-                    4
-                });
-                delete[] data;
+        case OpCodes::inve:
+        {
+            return cpu.Unary<uchar_t, Safe>([](uchar_t top) { return ~top; });
+        }
 
-                return err;
-            }
+        case OpCodes::invr:
+        {
+            RegisterModeFlags regMode { ins.reg1 };
 
-            case OpCodes::inve:
+            if (Is8BitReg(regMode))
             {
-                uchar_t byte { static_cast<uchar_t>(cpu.board.ram.Read(cpu.state.sp-1)) };
-                System::ErrorCode err { cpu.Pop() };
-
-                if (err != System::ErrorCode::Ok)
-                    return err;
-
-                byte = ~byte;
-                err = cpu.Push(byte);
-                return err;
+                uchar_t& reg { GetRegister8Bit(regMode, cpu.state) };
+                reg = ~reg;
             }
-
-            case OpCodes::invr:
+            else 
             {
-                RegisterModeFlags regMode { 
-                    cpu.board.assembly.Rom().Read(cpu.state.pc)
-                };
-
-                if (Is8BitReg(regMode))
-                {
-                    uchar_t& reg { GetRegister8Bit(regMode, cpu.state) };
-                    reg = ~reg;
-                }
-                else 
-                {
-                    sysbit_t& reg { GetRegister32Bit(regMode, cpu.state) };
-                    reg = ~reg;
-                }
-
-                return System::ErrorCode::Ok;
+                sysbit_t& reg { GetRegister32Bit(regMode, cpu.state) };
+                reg = ~reg;
             }
 
-            default:
-                return System::ErrorCode::InvalidInstruction;
-        }, 
-        
-        return exc.GetCode();, 
-        return System::ErrorCode::UnhandledException;
-    )
+            return System::ErrorCode::Ok;
+        }
+
+        default:
+            return System::ErrorCode::InvalidInstruction;
+    }
 }
 
-OPR CPU::InvertSafe(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::InvertSafe(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1)))
+    switch (ins.op)
+    {
+        case OpCodes::invst:
         {
-            case OpCodes::invst:
-            {
-                sysbit_t top32 { IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data 
-                )};
-
-                top32 = ~top32;
-
-                char* data { BytesFromInteger(
-                    top32
-                )};
-
-                Error err { cpu.PushSome({
-                    data,
-                    4
-                })};
-                delete[] data;
-
-                return err;
-            }
-
-            case OpCodes::invse:
-            {
-                uchar_t byte { static_cast<uchar_t>(cpu.board.ram.Read(cpu.state.sp-1)) };
+            return cpu.Unary<sysbit_t, Safe, true>([](sysbit_t top) { return ~top; });
+        }
 
-                byte = ~byte;
-                Error err { cpu.Push(byte) };
-                return err;
-            }
+        case OpCodes::invse:
+        {
+            return cpu.Unary<uchar_t, Safe, true>([](uchar_t top) { return ~top; });
+        }
 
-            default:
-                return System::ErrorCode::InvalidInstruction;
-        }, 
-        
-        return exc.GetCode();, 
-        return System::ErrorCode::UnhandledException;
-    )
+        default:
+            return System::ErrorCode::InvalidInstruction;
+    }
 }
 
 template<typename T>
@@ -1596,1191 +1193,740 @@ static bool CompareVarious(T lhs, T rhs, uchar_t mode)
     return false;
 }
 
-OPR CPU::Compare(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::Compare(CPU& cpu, const Instruction& ins) noexcept
 {
     using Numo = NumericModeFlags;
 
-    try_catch(
-        const uchar_t compressedModes { static_cast<const uchar_t>(
-            cpu.board.assembly.Rom().Read(cpu.state.pc)
-        )};
-        cpu.state.pc++;
+    const uchar_t compressedModes { ins.mode };
 
-        Numo numMode { 
-            static_cast<char>(compressedModes >> 5) 
-            // 11122222
-        };
-        const uchar_t compareMode {
-            static_cast<const uchar_t>(compressedModes & 0b00011111)
-        };
+    Numo numMode { 
+        static_cast<char>(compressedModes >> 5) 
+        // 11122222
+    };
+    const uchar_t compareMode {
+        static_cast<const uchar_t>(compressedModes & 0b00011111)
+    };
 
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-2)))
+    switch (ins.op)
+    {
+        case OpCodes::cmp:
         {
-            case OpCodes::cmp:
-            {
-                if (numMode == Numo::UInt)
-                {
-                    sysbit_t int1 { IntegerFromBytes<sysbit_t>(
-                        cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data
-                    )};
-                    sysbit_t int2 { IntegerFromBytes<sysbit_t>(
-                        cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data
-                    )};
-
-                    cpu.state.bl = CompareVarious(int1, int2, compareMode);
-                }
-                else if (numMode == Numo::Float)
-                {
-                    float float1 { FloatFromBytes(
-                        cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data
-                    )};
-                    float float2 { FloatFromBytes(
-                        cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data
-                    )};
-
-                    cpu.state.bl = CompareVarious(float1, float2, compareMode);
-                }
-                else if (numMode == Numo::Int)
-                {
-                    int int1 { IntegerFromBytes<int32_t>(
-                        cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data
-                    )};
-                    int int2 { IntegerFromBytes<int32_t>(
-                        cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data
-                    )};
-
-                    cpu.state.bl = CompareVarious(int1, int2, compareMode);
-                }
-                else if (numMode == Numo::UByte)
-                {
-                    uchar_t byte1 { static_cast<uchar_t>(
-                        cpu.board.ram.Read(cpu.state.sp-2)
-                    )};
-                    uchar_t byte2 { static_cast<uchar_t>(
-                        cpu.board.ram.Read(cpu.state.sp-1)
-                    )};
-
-                    cpu.state.bl = CompareVarious(byte1, byte2, compareMode);
-                }
-                else
-                {
-                    char byte1 { cpu.board.ram.Read(cpu.state.sp-2) };
-                    char byte2 { cpu.board.ram.Read(cpu.state.sp-1) };
-
-                    cpu.state.bl = CompareVarious(byte1, byte2, compareMode);
-                }
-                return System::ErrorCode::Ok;
-            }
+            // lhs under rhs, one bounds check for both
+            const auto Compared { [&cpu, compareMode](auto type) -> Error {
+                using T = decltype(type);
+                T lhs, rhs;
+                if (Error err { cpu.PeekValue<T, Safe>(lhs, 2*sizeof(T)) }; err != System::ErrorCode::Ok)
+                    return err;
+                cpu.PeekValue<T, false>(rhs, sizeof(T));
 
-            case OpCodes::cmpr:
-            {
-                RegisterModeFlags reg1mode {
-                    cpu.board.assembly.Rom().Read(cpu.state.pc++)
-                };
-                RegisterModeFlags reg2mode {
-                    cpu.board.assembly.Rom().Read(cpu.state.pc++)
-                };
-
-                sysbit_t reg1 { Is8BitReg(reg1mode) ? 
-                    GetRegister8Bit(reg1mode, cpu.state) :
-                    GetRegister32Bit(reg1mode, cpu.state)
-                };
-                sysbit_t reg2 { Is8BitReg(reg2mode) ? 
-                    GetRegister8Bit(reg2mode, cpu.state) :
-                    GetRegister32Bit(reg2mode, cpu.state)
-                };
-
-                if (numMode == Numo::UInt)
-                    cpu.state.bl = CompareVarious(reg1, reg2, compareMode);
-                else if (numMode == Numo::Float)
-                    cpu.state.bl = CompareVarious(
-                        static_cast<float>(reg1),
-                        static_cast<float>(reg2),
-                        compareMode
-                    );
-                else if (numMode == Numo::Int)
-                    cpu.state.bl = CompareVarious(
-                        static_cast<int>(reg1),
-                        static_cast<int>(reg2),
-                        compareMode
-                    );
-                else if (numMode == Numo::UByte)
-                    cpu.state.bl = CompareVarious(
-                        static_cast<uchar_t>(reg1),
-                        static_cast<uchar_t>(reg2),
-                        compareMode
-                    );
-                else
-                    cpu.state.bl = CompareVarious(
-                        static_cast<char>(reg1),
-                        static_cast<char>(reg2),
-                        compareMode
-                    );
+                cpu.state.bl = CompareVarious(lhs, rhs, compareMode);
                 return System::ErrorCode::Ok;
-            }
+            }};
+
+            if (numMode == Numo::UInt)
+                return Compared(sysbit_t{});
+            else if (numMode == Numo::Float)
+                return Compared(float{});
+            else if (numMode == Numo::Int)
+                return Compared(std::int32_t{});
+            else if (numMode == Numo::UByte)
+                return Compared(uchar_t{});
+            else
+                return Compared(char{});
+        }
 
-            default:
-                return System::ErrorCode::InvalidInstruction;
-        },
-        
-        return exc.GetCode();, 
-        return System::ErrorCode::UnhandledException;
-    )
-}
+        case OpCodes::cmpr:
+        {
+            RegisterModeFlags reg1mode { ins.reg1 };
+            RegisterModeFlags reg2mode { ins.reg2 };
+
+            sysbit_t reg1 { Is8BitReg(reg1mode) ? 
+                GetRegister8Bit(reg1mode, cpu.state) :
+                GetRegister32Bit(reg1mode, cpu.state)
+            };
+            sysbit_t reg2 { Is8BitReg(reg2mode) ? 
+                GetRegister8Bit(reg2mode, cpu.state) :
+                GetRegister32Bit(reg2mode, cpu.state)
+            };
 
-OPR CPU::PopInstruction(CPU& cpu) noexcept
+            if (numMode == Numo::UInt)
+                cpu.state.bl = CompareVarious(reg1, reg2, compareMode);
+            else if (numMode == Numo::Float)
+                cpu.state.bl = CompareVarious(
+                    static_cast<float>(reg1),
+                    static_cast<float>(reg2),
+                    compareMode
+                );
+            else if (numMode == Numo::Int)
+                cpu.state.bl = CompareVarious(
+                    static_cast<int>(reg1),
+                    static_cast<int>(reg2),
+                    compareMode
+                );
+            else if (numMode == Numo::UByte)
+                cpu.state.bl = CompareVarious(
+                    static_cast<uchar_t>(reg1),
+                    static_cast<uchar_t>(reg2),
+                    compareMode
+                );
+            else
+                cpu.state.bl = CompareVarious(
+                    static_cast<char>(reg1),
+                    static_cast<char>(reg2),
+                    compareMode
+                );
+            return System::ErrorCode::Ok;
+        }
+
+        default:
+            return System::ErrorCode::InvalidInstruction;
+    }
+}
+
+template<bool Safe>
+OPR CPU::PopInstruction(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1)))
-        {
-            case OpCodes::pope:
-                return cpu.Pop();
-            case OpCodes::popt:
-                return cpu.PopSome(4);
-            default:
-                return System::ErrorCode::InvalidInstruction;
-        }, 
-        
-        return exc.GetCode();, 
-        return System::ErrorCode::UnhandledException;
-    )
+    switch (ins.op)
+    {
+        case OpCodes::pope:
+            return cpu.Pop<Safe>();
+        case OpCodes::popt:
+            return cpu.PopSome<Safe>(4);
+        default:
+            return System::ErrorCode::InvalidInstruction;
+    }
 }
 
-OPR CPU::Jump(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::Jump(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1)))
+    switch (ins.op)
+    {
+        case OpCodes::jmpr:
         {
-            case OpCodes::jmpr:
-            {
-                sysbit_t address { GetRegister32Bit(
-                    RegisterModeFlags(cpu.board.assembly.Rom().Read(cpu.state.pc)),
-                    cpu.state
-                )};
+            sysbit_t address { GetRegister32Bit(
+                RegisterModeFlags(ins.reg1),
+                cpu.state
+            )};
 
-                // Safety test, address must be in bounds of rom
-                RomSafetyCheck(address);
+            // Safety test, address must be in bounds of rom
+            RomSafetyCheck(address);
 
-                cpu.state.pc = address;
-                return Error::Ok;
-            }
+            cpu.state.pc = address;
+            return Error::Ok;
+        }
 
-            case OpCodes::jmp:
-            {
-                sysbit_t address { IntegerFromBytes<sysbit_t>(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data 
-                )};
-                
-                // Safety test, address must be in bounds of rom
+        case OpCodes::jmp:
+        {
+            sysbit_t address { ins.imm };
+            
+            // Safety test, address must be in bounds of rom. Verified
+            // targets are instruction starts.
+            if constexpr (Safe)
                 RomSafetyCheck(address);
 
-                cpu.state.pc = address;
-                return Error::Ok;
-            }
+            if (address <= ins.pc)
+                Heat(ins.target);
 
-            default:
-                return Error::InvalidInstruction;
-        },
+            cpu.state.pc = address;
+            cpu.ip = ins.target;
+            return Error::Ok;
+        }
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+        default:
+            return Error::InvalidInstruction;
+    }
 }
 
-OPR CPU::SwapRange(CPU& cpu) noexcept
+OPR CPU::SwapRange(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        // swr <size: sysbit>  
-        sysbit_t size { IntegerFromBytes<sysbit_t>(
-            cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data
-        )};
+    // swr <size: sysbit>  
+    // swaps the top `size` bytes with the `size` bytes below them
+    const sysbit_t size { ins.imm };
+    if (size > cpu.state.sp/2)
+        return System::ErrorCode::RAMAccessError;
 
-        System::ErrorCode err { Error::Ok };
-        for (sysbit_t midpoint = cpu.state.sp-size; size > 0; size--)
-        {
-            char tmp { cpu.board.ram.Read(cpu.state.sp-size) };
-            err = err == Error::Ok ? cpu.board.ram.Write(
-                cpu.state.sp-size,
-                cpu.board.ram.Read(midpoint-size)   
-            ) : err;
-            err = err == Error::Ok ?
-                cpu.board.ram.Write(midpoint-size, tmp) 
-                : err;
-
-            if (err != Error::Ok)
-                return err;
-        }
-        
-        cpu.state.pc += 4;
-        return err;,
-
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    return cpu.board.ram.Swap(cpu.state.sp-2*size, cpu.state.sp-size, size);
 }
 
-OPR CPU::DuplicateRange(CPU& cpu) noexcept
+OPR CPU::DuplicateRange(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        // dur <size: sysbit>  
-        sysbit_t size { IntegerFromBytes<sysbit_t>(
-            cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data
-        )};
-
-        System::ErrorCode err { Error::Ok };
-        cpu.PushSome(
-            cpu.board.ram.ReadSome(cpu.state.sp-size, size)
-        );
-
-        cpu.state.pc += 4;
-        return err;,
-
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    // dur <size: sysbit>  
+    const sysbit_t size { ins.imm };
+    if (size > cpu.state.sp)
+        return System::ErrorCode::RAMAccessError;
+    if (cpu.state.sp+size > cpu.board.ram.StackSize())
+        return cpu.Overflow();
+
+    Error err { cpu.board.ram.Copy(cpu.state.sp, cpu.state.sp-size, size) };
+    if (err == Error::Ok)
+        cpu.state.sp += size;
+    return err;
 }
 
-OPR CPU::Repeat(CPU& cpu) noexcept
+OPR CPU::Repeat(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        // rep <compressed(mem/num)> <count> <val>
-        MemoryModeFlags memMode;
-        NumericModeFlags numMode;
-        const uchar_t compressed { static_cast<uchar_t>(
-            cpu.board.assembly.Rom().Read(cpu.state.pc)
-        )};
+    // rep <compressed(mem/num)> <count> <val>
+    MemoryModeFlags memMode;
+    NumericModeFlags numMode;
+    const uchar_t compressed { ins.mode};
 
-        memMode = MemoryModeFlags(compressed >> 4);
-        numMode = NumericModeFlags(compressed & 0b00001111);
+    memMode = MemoryModeFlags(compressed >> 4);
+    numMode = NumericModeFlags(compressed & 0b00001111);
 
-        cpu.state.pc++;
-        const sysbit_t count { IntegerFromBytes<sysbit_t>(
-            cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data
-        )};
-        cpu.state.pc += 4;
+    const sysbit_t count { ins.imm };
 
-        const Slice valueData {
-            cpu.board.assembly.Rom().ReadSome(cpu.state.pc, ByteSize(numMode))
-        };
-        cpu.state.pc += ByteSize(numMode);
+    // the value comes from ROM, which is always big endian
+    char value[sizeof(sysbit_t)];
+    if (ByteSize(numMode) == sizeof(sysbit_t))
+        IntegerToRam(IntegerFromBytes<sysbit_t>(ins.data), value);
+    else
+        value[0] = ins.data[0];
+    const Slice valueData (value, ByteSize(numMode));
 
-        sysbit_t address;
-        if (memMode == MemoryModeFlags::Heap)
-            address = cpu.state.ebx;
-        else
+    sysbit_t address;
+    if (memMode == MemoryModeFlags::Heap)
+        address = cpu.state.ebx;
+    else
+    {
+        if (cpu.state.sp + count*ByteSize(numMode) > cpu.board.ram.StackSize())
         {
-            if (cpu.state.sp + count*ByteSize(numMode) > cpu.board.ram.StackSize())
-                CRASH(
-                    Error::StackOverflow, 
-                    "In ", cpu.board.Stringify(), " instruction rep. Can't push onto stack, it's full"
-                );
-            address = cpu.state.sp;
-            cpu.state.sp += count*ByteSize(numMode);
+            LOGE(
+                System::LogLevel::Medium,
+                "In ", cpu.board.Stringify(), " instruction rep. Can't push onto stack, it's full"
+            );
+            return Error::StackOverflow;
         }
-        
-        System::ErrorCode err { Error::Ok };
-        for (sysbit_t i = 0; (i < count) && (err == Error::Ok); i++, address += ByteSize(numMode))
-            err = err == Error::Ok ? 
-                cpu.board.ram.WriteSome(address, valueData) :
-                err;
-
-        return err;,
+        address = cpu.state.sp;
+        cpu.state.sp += count*ByteSize(numMode);
+    }
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )   
+    return cpu.board.ram.Fill(address, valueData, count);
 }
 
-OPR CPU::Allocate(CPU& cpu) noexcept
+OPR CPU::Allocate(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        const sysbit_t address { cpu.board.ram.Allocate(cpu.state.ecx) };
-        cpu.state.ebx = address;
-        return Error::Ok;,
-        
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    sysbit_t address { 0 };
+    Error err { cpu.board.ram.Allocate(cpu.state.ecx, address) };
+    if (cpu.board.profile != nullptr)
+    {
+        if (err == System::ErrorCode::Ok)
+            cpu.board.profile->Allocated(cpu.board.ram, ins.pc, address, cpu.state.ecx);
+        else
+            cpu.board.profile->Failed(ins.pc);
+    }
+
+    if (err != System::ErrorCode::Ok)
+        return err;
+
+    cpu.state.ebx = address;
+    return Error::Ok;
 }
 
-OPR CPU::PowRegister(CPU& cpu) noexcept
+OPR CPU::PowRegister(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        float base;
-        float power;
-        OpCodes op { cpu.board.assembly.Rom().Read(cpu.state.pc-1) };
-        RegisterModeFlags reg1 { cpu.board.assembly.Rom().Read(cpu.state.pc++)};
-        RegisterModeFlags reg2 { cpu.board.assembly.Rom().Read(cpu.state.pc++)};
+    float base;
+    float power;
+    OpCodes op { ins.op };
+    RegisterModeFlags reg1 { ins.reg1 };
+    RegisterModeFlags reg2 { ins.reg2 };
 
-        switch (op) 
+    switch (op) 
+    {
+        case OpCodes::powri:
         {
-            case OpCodes::powri:
-            {
-                base = static_cast<float>(GetRegister32Bit(reg1, cpu.state));
-                power = static_cast<float>(GetRegister32Bit(reg2, cpu.state));
-                sysbit_t res { static_cast<sysbit_t>(std::pow(base, power)) };
-                GetRegister32Bit(reg2, cpu.state) = res;
-                break;
-            }
+            base = static_cast<float>(GetRegister32Bit(reg1, cpu.state));
+            power = static_cast<float>(GetRegister32Bit(reg2, cpu.state));
+            sysbit_t res { static_cast<sysbit_t>(std::pow(base, power)) };
+            GetRegister32Bit(reg2, cpu.state) = res;
+            break;
+        }
 
-            case OpCodes::powrf:
-            {
-                char* bytes;
-
-                bytes = BytesFromInteger<sysbit_t>(GetRegister32Bit(reg1, cpu.state));
-                base = FloatFromBytes(bytes);
-                delete[] bytes;
-                
-                bytes = BytesFromInteger<sysbit_t>(GetRegister32Bit(reg2, cpu.state));
-                power = FloatFromBytes(bytes);
-                delete[] bytes;
-
-                float res { std::pow(base, power) };
-                bytes = BytesFromFloat(res);
-                GetRegister32Bit(reg2, cpu.state) = IntegerFromBytes<sysbit_t>(bytes);
-                delete[] bytes;
-                break;
-            }
+        case OpCodes::powrf:
+        {
+
+            base = std::bit_cast<float>(GetRegister32Bit(reg1, cpu.state));
             
-            case OpCodes::powrb:
-            {
-                base = static_cast<float>(GetRegister8Bit(reg1, cpu.state));
-                power = static_cast<float>(GetRegister8Bit(reg2, cpu.state));
-                uchar_t res { static_cast<uchar_t>(std::pow(base, power)) };
-                GetRegister8Bit(reg2, cpu.state) = res;
-                break;
-            }
+            power = std::bit_cast<float>(GetRegister32Bit(reg2, cpu.state));
 
-            default:
-                return Error::InvalidInstruction;
+            float res { std::pow(base, power) };
+            GetRegister32Bit(reg2, cpu.state) = std::bit_cast<sysbit_t>(res);
+            break;
+        }
+        
+        case OpCodes::powrb:
+        {
+            base = static_cast<float>(GetRegister8Bit(reg1, cpu.state));
+            power = static_cast<float>(GetRegister8Bit(reg2, cpu.state));
+            uchar_t res { static_cast<uchar_t>(std::pow(base, power)) };
+            GetRegister8Bit(reg2, cpu.state) = res;
+            break;
         }
 
-        return Error::Ok;, 
+        default:
+            return Error::InvalidInstruction;
+    }
 
-        return exc.GetCode();, 
-        return System::ErrorCode::UnhandledException;
-    )
+    return Error::Ok;
 }
 
-OPR CPU::PowStack(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::PowStack(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        float base;
-        float power;
-        System::ErrorCode err;
-
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1))) 
-        {
-            case OpCodes::powsi:
-            {
-                base = static_cast<float>(IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data
-                ));
-                power = static_cast<float>(IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data
-                ));
-
-                err = cpu.PopSome(8);
-                if (err != System::ErrorCode::Ok)
-                    return err;
-
-                sysbit_t res { static_cast<sysbit_t>(std::pow(base, power)) };
-                char* bytes { BytesFromInteger<sysbit_t>(res) };
-                err = cpu.PushSome({bytes, 4});
-                delete[] bytes;
-
-                return err;
-            }
-
-            case OpCodes::powsf:
-            {
-                base = FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data);
-                power = FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data);
-
-                err = cpu.PopSome(8);
-                if (err != System::ErrorCode::Ok)
-                    return err;
-
-                float res { std::pow(base, power) };
-                char* bytes { BytesFromFloat(res) };
-                err = cpu.PushSome({bytes, 4});
-                delete[] bytes;
-
-                return err;
-            }
-            
-            case OpCodes::powsb:
-            {
-                base = static_cast<float>(cpu.board.ram.Read(cpu.state.sp-2));
-                power = static_cast<float>(cpu.board.ram.Read(cpu.state.sp-1));
-
-                err = cpu.PopSome(2);
-                if (err != System::ErrorCode::Ok)
-                    return err;
-
-                uchar_t res { static_cast<uchar_t>(std::pow(base, power)) };
-                err = cpu.Push(res);
-                return err;
-            }
-
-            default:
-                return Error::InvalidInstruction;
-        }, 
+    switch (ins.op) 
+    {
+        case OpCodes::powsi:
+            return cpu.Binary<sysbit_t, Safe>([](sysbit_t base, sysbit_t power) {
+                return static_cast<sysbit_t>(std::pow(static_cast<float>(base), static_cast<float>(power)));
+            });
+
+        case OpCodes::powsf:
+            return cpu.Binary<float, Safe>([](float base, float power) {
+                return std::pow(base, power);
+            });
+        
+        case OpCodes::powsb:
+            return cpu.Binary<char, Safe>([](char base, char power) {
+                return static_cast<uchar_t>(std::pow(static_cast<float>(base), static_cast<float>(power)));
+            });
 
-        return exc.GetCode();, 
-        return System::ErrorCode::UnhandledException;
-    )
+        default:
+            return Error::InvalidInstruction;
+    }
 }
 
-OPR CPU::PowConst(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::PowConst(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        float base;
-        float power;
-        System::ErrorCode err;
+    float base;
+    float power;
 
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1))) 
+    switch (ins.op) 
+    {
+        case OpCodes::powi:
         {
-            case OpCodes::powi:
-            {
-                base = static_cast<float>(IntegerFromBytes<sysbit_t>(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data
-                ));
-                power = static_cast<float>(IntegerFromBytes<sysbit_t>(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc+4, 4).data
-                ));
-                cpu.state.pc += 8;
-
-                sysbit_t res { static_cast<sysbit_t>(std::pow(base, power)) };
-                char* bytes { BytesFromInteger<sysbit_t>(res) };
-                err = cpu.PushSome({bytes, 4});
-                delete[] bytes;
+            base = static_cast<float>(ins.imm);
+            power = static_cast<float>(ins.imm2);
 
-                return err;
-            }
-
-            case OpCodes::powf:
-            {
-                base = FloatFromBytes(cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data);
-                power = FloatFromBytes(cpu.board.assembly.Rom().ReadSome(cpu.state.pc+4, 4).data);
-                cpu.state.pc += 8;
-
-                float res { std::pow(base, power) };
-                char* bytes { BytesFromFloat(res) };
-                err = cpu.PushSome({bytes, 4});
-                delete[] bytes;
+            return cpu.PushU32<Safe>(static_cast<sysbit_t>(std::pow(base, power)));
+        }
 
-                return err;
-            }
-            
-            case OpCodes::powb:
-            {
-                base = static_cast<float>(cpu.board.assembly.Rom().Read(cpu.state.pc));
-                power = static_cast<float>(cpu.board.assembly.Rom().Read(cpu.state.pc+1));
-                cpu.state.pc += 2;
+        case OpCodes::powf:
+        {
+            base = std::bit_cast<float>(ins.imm);
+            power = std::bit_cast<float>(ins.imm2);
 
-                uchar_t res { static_cast<uchar_t>(std::pow(base, power)) };
-                err = cpu.Push(res);
-                return err;
-            }
+            return cpu.PushF32<Safe>(std::pow(base, power));
+        }
+        
+        case OpCodes::powb:
+        {
+            base = static_cast<float>(static_cast<char>(ins.imm));
+            power = static_cast<float>(static_cast<char>(ins.imm2));
 
-            default:
-                return Error::InvalidInstruction;
-        }, 
+            return cpu.PushU8<Safe>(static_cast<uchar_t>(std::pow(base, power)));
+        }
 
-        return exc.GetCode();, 
-        return System::ErrorCode::UnhandledException;
-    )
+        default:
+            return Error::InvalidInstruction;
+    }
 }
 
-OPR CPU::SqrtRegister(CPU& cpu) noexcept
+OPR CPU::SqrtRegister(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        float num;
-        OpCodes op { cpu.board.assembly.Rom().Read(cpu.state.pc-1) };
-        RegisterModeFlags reg { cpu.board.assembly.Rom().Read(cpu.state.pc++)};
+    float num;
+    OpCodes op { ins.op };
+    RegisterModeFlags reg { ins.reg1 };
 
-        switch (op) 
+    switch (op) 
+    {
+        case OpCodes::sqrri:
         {
-            case OpCodes::sqrri:
-            {
-                num = static_cast<float>(GetRegister32Bit(reg, cpu.state));
-                sysbit_t res { static_cast<sysbit_t>(std::sqrt(num)) };
-                cpu.state.eax = res;
-                break;
-            }
+            num = static_cast<float>(GetRegister32Bit(reg, cpu.state));
+            sysbit_t res { static_cast<sysbit_t>(std::sqrt(num)) };
+            cpu.state.eax = res;
+            break;
+        }
 
-            case OpCodes::sqrrf:
-            {
-                char* bytes;
-
-                bytes = BytesFromInteger<sysbit_t>(GetRegister32Bit(reg, cpu.state));
-                num = FloatFromBytes(bytes);
-                delete[] bytes;
-                
-                float res { std::sqrt(num) };
-                bytes = BytesFromFloat(res);
-                cpu.state.eax = IntegerFromBytes<sysbit_t>(bytes);
-                delete[] bytes;
-                break;
-            }
-            
-            case OpCodes::sqrrb:
-            {
-                num = static_cast<float>(GetRegister8Bit(reg, cpu.state));
-                uchar_t res { static_cast<uchar_t>(std::sqrt(num)) };
-                cpu.state.al = res;
-                break;
-            }
+        case OpCodes::sqrrf:
+        {
 
-            default:
-                return Error::InvalidInstruction;
+            num = std::bit_cast<float>(GetRegister32Bit(reg, cpu.state));
+            
+            float res { std::sqrt(num) };
+            cpu.state.eax = std::bit_cast<sysbit_t>(res);
+            break;
+        }
+        
+        case OpCodes::sqrrb:
+        {
+            num = static_cast<float>(GetRegister8Bit(reg, cpu.state));
+            uchar_t res { static_cast<uchar_t>(std::sqrt(num)) };
+            cpu.state.al = res;
+            break;
         }
 
-        return Error::Ok;, 
+        default:
+            return Error::InvalidInstruction;
+    }
 
-        return exc.GetCode();, 
-        return System::ErrorCode::UnhandledException;
-    )
+    return Error::Ok;
 }
 
-OPR CPU::SqrtStack(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::SqrtStack(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        float num;
-        System::ErrorCode err;
-
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1))) 
-        {
-            case OpCodes::sqrsi:
-            {
-                num = static_cast<float>(IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data
-                ));
-
-                err = cpu.PopSome(4);
-                if (err != System::ErrorCode::Ok)
-                    return err;
-
-                sysbit_t res { static_cast<sysbit_t>(std::sqrt(num)) };
-                char* bytes { BytesFromInteger<sysbit_t>(res) };
-                err = cpu.PushSome({bytes, 4});
-                delete[] bytes;
-
-                return err;
-            }
-
-            case OpCodes::sqrsf:
-            {
-                num = FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data);
-
-                err = cpu.PopSome(4);
-                if (err != System::ErrorCode::Ok)
-                    return err;
-
-                float res { std::sqrt(num) };
-                char* bytes { BytesFromFloat(res) };
-                err = cpu.PushSome({bytes, 4});
-                delete[] bytes;
-
-                return err;
-            }
-            
-            case OpCodes::sqrsb:
-            {
-                num = static_cast<float>(cpu.board.ram.Read(cpu.state.sp-1));
-
-                err = cpu.PopSome(1);
-                if (err != System::ErrorCode::Ok)
-                    return err;
-
-                uchar_t res { static_cast<uchar_t>(std::sqrt(num)) };
-                err = cpu.Push(res);
-                return err;
-            }
+    switch (ins.op) 
+    {
+        case OpCodes::sqrsi:
+            return cpu.Unary<sysbit_t, Safe>([](sysbit_t num) {
+                return static_cast<sysbit_t>(std::sqrt(static_cast<float>(num)));
+            });
 
-            default:
-                return Error::InvalidInstruction;
-        }, 
+        case OpCodes::sqrsf:
+            return cpu.Unary<float, Safe>([](float num) { return std::sqrt(num); });
+        
+        case OpCodes::sqrsb:
+            return cpu.Unary<char, Safe>([](char num) {
+                return static_cast<uchar_t>(std::sqrt(static_cast<float>(num)));
+            });
 
-        return exc.GetCode();, 
-        return System::ErrorCode::UnhandledException;
-    )
+        default:
+            return Error::InvalidInstruction;
+    }
 }
 
-OPR CPU::SqrtConst(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::SqrtConst(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        float num;
-        System::ErrorCode err;
+    float num;
 
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1)))    
+    switch (ins.op)    
+    {
+        case OpCodes::sqri:
         {
-            case OpCodes::sqri:
-            {
-                num = static_cast<float>(IntegerFromBytes<sysbit_t>(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data
-                ));
-                cpu.state.pc += 4;
-
-                sysbit_t res { static_cast<sysbit_t>(std::sqrt(num)) };
-                char* bytes { BytesFromInteger(res) };
-                err = cpu.PushSome({bytes, 4});
-
-                delete[] bytes;
-                return err;
-            }
-
-            case OpCodes::sqrf:
-            {
-                num = FloatFromBytes(
-                    cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data
-                ); 
-                cpu.state.pc += 4;
-
-                float res { std::sqrt(num) };
-                char* bytes { BytesFromFloat(res) };
-                err = cpu.PushSome({bytes, 4});
-
-                delete[] bytes;
-                return err;
-            }
-
-            case OpCodes::sqrb:
-            {
-                num = static_cast<float>(cpu.board.assembly.Rom().Read(cpu.state.pc));
-                cpu.state.pc++;
-
-                uchar_t res { static_cast<uchar_t>(std::sqrt(num)) };
-                err = cpu.Push(res);
+            num = static_cast<float>(ins.imm);
+            return cpu.PushU32<Safe>(static_cast<sysbit_t>(std::sqrt(num)));
+        }
 
-                return err;
-            }
+        case OpCodes::sqrf:
+        {
+            num = std::bit_cast<float>(ins.imm); 
+            return cpu.PushF32<Safe>(std::sqrt(num));
+        }
 
-            default:
-                return System::ErrorCode::InvalidInstruction;
-        },
+        case OpCodes::sqrb:
+        {
+            num = static_cast<float>(static_cast<char>(ins.imm));
+            return cpu.PushU8<Safe>(static_cast<uchar_t>(std::sqrt(num)));
+        }
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+        default:
+            return System::ErrorCode::InvalidInstruction;
+    }
 }
 
-OPR CPU::ConditionalJump(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::ConditionalJump(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        OpCodes op { OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1)) };
-        sysbit_t address;
+    OpCodes op { ins.op };
+    sysbit_t address;
 
-        if (cpu.state.bl == 0)
-            address = cpu.state.pc + ((op == OpCodes::cnd) ? 4 : 1);
-        else if (op == OpCodes::cnd)
-            address = IntegerFromBytes<sysbit_t>(
-                cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data 
-            );
-        else if (op == OpCodes::cndr)
-            address = GetRegister32Bit(
-                RegisterModeFlags(cpu.board.assembly.Rom().Read(cpu.state.pc)),
-                cpu.state
-            );
-        else
-            return System::ErrorCode::InvalidInstruction;
+    // not taken, pc already points past the operands
+    if (cpu.state.bl == 0)
+        return System::ErrorCode::Ok;
+    else if (op == OpCodes::cnd)
+        address = ins.imm;
+    else if (op == OpCodes::cndr)
+        address = GetRegister32Bit(
+            RegisterModeFlags(ins.reg1),
+            cpu.state
+        );
+    else
+        return System::ErrorCode::InvalidInstruction;
 
-        // Safety test, address must be in bounds of rom
+    // Safety test, address must be in bounds of rom. Verified static
+    // targets are instruction starts.
+    if (Safe || op == OpCodes::cndr)
+    {
         RomSafetyCheck(address);
-        cpu.state.pc = address;
-        return System::ErrorCode::Ok;,
+    }
+    if (op == OpCodes::cnd && address <= ins.pc)
+        Heat(ins.target);
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    ) 
+    cpu.state.pc = address;
+    cpu.ip = op == OpCodes::cnd ? ins.target : InstructionStream::npos;
+    return System::ErrorCode::Ok;
 }
 
-OPR CPU::CallFunc(CPU &cpu) noexcept
+OPR CPU::CallFunc(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        if (cpu.state.sp < cpu.state.bl)
-            return System::ErrorCode::RAMAccessError;
+    if (cpu.state.sp < cpu.state.bl)
+        return System::ErrorCode::RAMAccessError;
+
+    OpCodes op { ins.op };
+    sysbit_t address;
+    if (op == OpCodes::cal)
+        address = ins.imm;
+    if (op == OpCodes::calr)
+        address = GetRegister32Bit( 
+            RegisterModeFlags(ins.reg1),
+            cpu.state
+        );
+    ReadSomeChecked(paramsData, cpu.state.sp-cpu.state.bl, cpu.state.bl)
+    const Slice params { paramsData, cpu.state.bl };
 
-        OpCodes op { OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1)) };
-        sysbit_t address;
-        if (op == OpCodes::cal)
-            address = IntegerFromBytes<sysbit_t>(
-                cpu.board.assembly.Rom().ReadSome(cpu.state.pc, 4).data
-            );
-        if (op == OpCodes::calr)
-            address = GetRegister32Bit( 
-                RegisterModeFlags(
-                    cpu.board.assembly.Rom().Read(cpu.state.pc)
-                ),
-                cpu.state
+    // (cpu.state.flg & 1) is the syscall flag
+    // make syscall
+    if (cpu.state.flg & 1)
+    {
+        // address is now the function id, cal was linked to its slot at load
+        const SysFunctionHandler handler {
+            op == OpCodes::cal
+                ? cpu.board.assembly.SysCallHandler().Resolve(ins.slot, address)
+                : cpu.board.assembly.SysCallHandler().Find(address)
+        };
+        if (handler == nullptr)
+        {
+            LOGE(
+                System::LogLevel::Medium,
+                "Error while syscall, no handler with key ", std::to_string(address), "."
             );
-        const Slice params { cpu.board.ram.ReadSome(cpu.state.sp-cpu.state.bl, cpu.state.bl) };
+            return Error::InvalidKey;
+        }
 
-        // (cpu.state.flg & 1) is the syscall flag
-        // make syscall
-        if (cpu.state.flg & 1)
-        {
-            if (op == OpCodes::cal)
-                cpu.state.pc += 4;
-           
-            // address is now the function id
-            std::unique_ptr<const char[]> ret {
-                cpu.board.assembly.SysCallHandler()(address, (params.size != 0) ? params.data : nullptr)
-            };
+        std::unique_ptr<const char[]> ret {
+            handler((params.size != 0) ? params.data : nullptr)
+        };
 
-            cpu.state.bl = ret == nullptr ? 0 : ret[1];
+        cpu.state.bl = ret == nullptr ? 0 : ret[1];
 
-            // function is void and returned without and error
-            if (ret.get() == nullptr)
-                return Error::Ok;
+        // function is void and returned without and error
+        if (ret.get() == nullptr)
+            return Error::Ok;
+
+        System::ErrorCode err { ret[0] };
 
-            System::ErrorCode err { ret[0] };
+        if (err != Error::Ok)
+        {
+            LOGE(
+                System::LogLevel::Medium,
+                "Error in syscall ",
+                std::to_string(address),
+                " ", System::ErrorCodeString(err)
+            );
+            return err;
+        }
+
+        if (ret[1] != 0)
+        {
+            Slice retVal (ret.get()+2, ret[1]);
+            err = cpu.PushSome(retVal);
 
             if (err != Error::Ok)
             {
                 LOGE(
                     System::LogLevel::Medium,
-                    "Error in syscall ",
+                    "Error in syscall, ",
                     std::to_string(address),
-                    " ", System::ErrorCodeString(err)
+                    " couldn't handle return values."
                 );
                 return err;
             }
-
-            if (ret[1] != 0)
-            {
-                Slice retVal (ret.get()+2, ret[1]);
-                err = cpu.PushSome(retVal);
-
-                if (err != Error::Ok)
-                {
-                    LOGE(
-                        System::LogLevel::Medium,
-                        "Error in syscall, ",
-                        std::to_string(address),
-                        " couldn't handle return values."
-                    );
-                    return err;
-                }
-            }
-
-            return Error::Ok;
         }
 
-        // normal call
-        // Create callstack
-        //  - Store bp
-        //  - Store pc
-        //  - Change bp
-        // Copy params
+        return Error::Ok;
+    }
 
-        // Store bp
-        char* bytes { BytesFromInteger(cpu.state.bp) };
-        cpu.PushSome({bytes, 4});
-        delete[] bytes;
+    // normal call
+    // Create callstack
+    //  - Store bp
+    //  - Store pc
+    //  - Change bp
+    // Copy params
 
-        // Store pc 
-        bytes = BytesFromInteger(cpu.state.pc + (op == OpCodes::cal ? 4 : 1));
-        cpu.PushSome({bytes, 4});
-        delete[] bytes;
+    // Store bp
+    cpu.PushU32(cpu.state.bp);
 
-        // Change pc and bp
-        cpu.state.pc = address;
-        cpu.state.bp = cpu.state.sp;
+    // Store pc 
+    cpu.PushU32(ins.next);
 
-        // Copy params 
-        System::ErrorCode err;
-        err = cpu.PushSome(params);
+    // Change pc and bp
+    cpu.state.pc = address;
+    cpu.ip = op == OpCodes::cal ? ins.target : InstructionStream::npos;
+    cpu.state.bp = cpu.state.sp;
+    if (op == OpCodes::cal)
+        Heat(ins.target);
 
-        return err;,
+    // Copy params 
+    System::ErrorCode err;
+    err = cpu.PushSome(params);
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    return err;
 }
 
-OPR CPU::MulRegister(CPU& cpu) noexcept
+OPR CPU::MulRegister(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        OpCodes op { cpu.board.assembly.Rom().Read(cpu.state.pc-1) };
-        RegisterModeFlags reg1 { cpu.board.assembly.Rom().Read(cpu.state.pc++)};
-        RegisterModeFlags reg2 { cpu.board.assembly.Rom().Read(cpu.state.pc++)};
+    OpCodes op { ins.op };
+    RegisterModeFlags reg1 { ins.reg1 };
+    RegisterModeFlags reg2 { ins.reg2 };
 
-        switch (op) 
+    switch (op) 
+    {
+        case OpCodes::mulri:
         {
-            case OpCodes::mulri:
-            {
-                sysbit_t lhs { GetRegister32Bit(reg1, cpu.state) };
-                sysbit_t& rhs { GetRegister32Bit(reg2, cpu.state) };
-                rhs *= lhs;
-                break;
-            }
-
-            case OpCodes::mulrf:
-            {
-                char* bytes;
-                bytes = BytesFromInteger<sysbit_t>(GetRegister32Bit(reg1, cpu.state));
-                float lhs { FloatFromBytes(bytes) };
-                delete[] bytes;
-                
-                bytes = BytesFromInteger<sysbit_t>(GetRegister32Bit(reg2, cpu.state));
-                float rhs { FloatFromBytes(bytes) };
-                delete[] bytes;
-
-                bytes = BytesFromFloat(lhs * rhs);
-                GetRegister32Bit(reg2, cpu.state) = IntegerFromBytes<sysbit_t>(bytes);
-                delete[] bytes;
-
-                break;
-            }
-            
-            case OpCodes::mulrb:
-            {
-                uchar_t lhs { GetRegister8Bit(reg1, cpu.state) };
-                uchar_t& rhs { GetRegister8Bit(reg2, cpu.state) };
-                rhs *= lhs;
-                break;
-            }
-
-            default:
-                return Error::InvalidInstruction;
+            sysbit_t lhs { GetRegister32Bit(reg1, cpu.state) };
+            sysbit_t& rhs { GetRegister32Bit(reg2, cpu.state) };
+            rhs *= lhs;
+            break;
         }
 
-        return Error::Ok;, 
-
-        return exc.GetCode();, 
-        return System::ErrorCode::UnhandledException;
-    )
-}
-
-OPR CPU::MulStack(CPU& cpu) noexcept
-{
-    try_catch(
-        System::ErrorCode err;
-
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1))) 
+        case OpCodes::mulrf:
         {
-            case OpCodes::muli:
-            {
-                if (cpu.state.sp < 4)
-                    return System::ErrorCode::RAMAccessError;
-
-                sysbit_t lhs { IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data
-                )};
-                sysbit_t rhs { IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data
-                )};
-
-                err = cpu.PopSome(8);
-                if (err != System::ErrorCode::Ok)
-                    return err;
-
-                sysbit_t res { lhs * rhs };
-                char* bytes { BytesFromInteger<sysbit_t>(res) };
-                err = cpu.PushSome({bytes, 4});
-                delete[] bytes;
-
-                return err;
-            }
-
-            case OpCodes::mulf:
-            {
-                if (cpu.state.sp < 4)
-                    return System::ErrorCode::RAMAccessError;
-
-                float lhs { FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data) };
-                float rhs { FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data) };
-
-                err = cpu.PopSome(8);
-                if (err != System::ErrorCode::Ok)
-                    return err;
-
-                float res { lhs * rhs };
-                char* bytes { BytesFromFloat(res) };
-                err = cpu.PushSome({bytes, 4});
-                delete[] bytes;
-
-                return err;
-            }
+            float lhs { std::bit_cast<float>(GetRegister32Bit(reg1, cpu.state)) };
             
-            case OpCodes::mulb:
-            {
-                uchar_t lhs { static_cast<uchar_t>(cpu.board.ram.Read(cpu.state.sp-2)) };
-                uchar_t rhs { static_cast<uchar_t>(cpu.board.ram.Read(cpu.state.sp-1)) };
+            float rhs { std::bit_cast<float>(GetRegister32Bit(reg2, cpu.state)) };
 
-                err = cpu.PopSome(2);
-                if (err != System::ErrorCode::Ok)
-                    return err;
+            GetRegister32Bit(reg2, cpu.state) = std::bit_cast<sysbit_t>(lhs * rhs);
 
-                uchar_t res { static_cast<uchar_t>(lhs * rhs) };
-                err = cpu.Push(res);
-                return err;
-            }
+            break;
+        }
+        
+        case OpCodes::mulrb:
+        {
+            uchar_t lhs { GetRegister8Bit(reg1, cpu.state) };
+            uchar_t& rhs { GetRegister8Bit(reg2, cpu.state) };
+            rhs *= lhs;
+            break;
+        }
 
-            default:
-                return Error::InvalidInstruction;
-        }, 
+        default:
+            return Error::InvalidInstruction;
+    }
 
-        return exc.GetCode();, 
-        return System::ErrorCode::UnhandledException;
-    )
+    return Error::Ok;
 }
 
-OPR CPU::MulSafe(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::MulStack(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        System::ErrorCode err;
-
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1))) 
-        {
-            case OpCodes::mulsi:
-            {
-                if (cpu.state.sp < 4)
-                    return System::ErrorCode::RAMAccessError;
-
-                sysbit_t lhs { IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data
-                )};
-                sysbit_t rhs { IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data
-                )};
-
-                sysbit_t res { lhs * rhs };
-                char* bytes { BytesFromInteger<sysbit_t>(res) };
-                err = cpu.PushSome({bytes, 4});
-                delete[] bytes;
-
-                return err;
-            }
-
-            case OpCodes::mulsf:
-            {
-                if (cpu.state.sp < 4)
-                    return System::ErrorCode::RAMAccessError;
-
-                float lhs { FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data) };
-                float rhs { FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data) };
-
-                float res { lhs * rhs };
-                char* bytes { BytesFromFloat(res) };
-                err = cpu.PushSome({bytes, 4});
-                delete[] bytes;
-
-                return err;
-            }
-            
-            case OpCodes::mulsb:
-            {
-                uchar_t lhs { static_cast<uchar_t>(cpu.board.ram.Read(cpu.state.sp-2)) };
-                uchar_t rhs { static_cast<uchar_t>(cpu.board.ram.Read(cpu.state.sp-1)) };
-
-                uchar_t res { static_cast<uchar_t>(lhs * rhs) };
-                err = cpu.Push(res);
-                return err;
-            }
+    switch (ins.op) 
+    {
+        case OpCodes::muli:
+            return cpu.Binary<sysbit_t, Safe>([](sysbit_t lhs, sysbit_t rhs) { return lhs * rhs; });
 
-            default:
-                return Error::InvalidInstruction;
-        }, 
+        case OpCodes::mulf:
+            return cpu.Binary<float, Safe>([](float lhs, float rhs) { return lhs * rhs; });
+        
+        case OpCodes::mulb:
+            return cpu.Binary<uchar_t, Safe>([](uchar_t lhs, uchar_t rhs) { return lhs * rhs; });
 
-        return exc.GetCode();, 
-        return System::ErrorCode::UnhandledException;
-    )
+        default:
+            return Error::InvalidInstruction;
+    }
 }
 
-OPR CPU::DivRegister(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::MulSafe(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        OpCodes op { cpu.board.assembly.Rom().Read(cpu.state.pc-1) };
-        RegisterModeFlags reg1 { cpu.board.assembly.Rom().Read(cpu.state.pc++)};
-        RegisterModeFlags reg2 { cpu.board.assembly.Rom().Read(cpu.state.pc++)};
-
-        switch (op) 
-        {
-            case OpCodes::divri:
-            {
-                sysbit_t lhs { GetRegister32Bit(reg1, cpu.state) };
-                sysbit_t& rhs { GetRegister32Bit(reg2, cpu.state) };
-                rhs = lhs / rhs;
-                break;
-            }
-
-            case OpCodes::divrf:
-            {
-                char* bytes;
-                bytes = BytesFromInteger<sysbit_t>(GetRegister32Bit(reg1, cpu.state));
-                float lhs { FloatFromBytes(bytes) };
-                delete[] bytes;
-                
-                bytes = BytesFromInteger<sysbit_t>(GetRegister32Bit(reg2, cpu.state));
-                float rhs { FloatFromBytes(bytes) };
-                delete[] bytes;
-
-                bytes = BytesFromFloat(lhs / rhs);
-                GetRegister32Bit(reg2, cpu.state) = IntegerFromBytes<sysbit_t>(bytes);
-                delete[] bytes;
-
-                break;
-            }
-            
-            case OpCodes::divrb:
-            {
-                uchar_t lhs { GetRegister8Bit(reg1, cpu.state) };
-                uchar_t& rhs { GetRegister8Bit(reg2, cpu.state) };
-                rhs = lhs / rhs;
-                break;
-            }
-
-            default:
-                return Error::InvalidInstruction;
-        }
+    switch (ins.op) 
+    {
+        case OpCodes::mulsi:
+            return cpu.Binary<sysbit_t, Safe, true>([](sysbit_t lhs, sysbit_t rhs) { return lhs * rhs; });
 
-        return Error::Ok;, 
+        case OpCodes::mulsf:
+            return cpu.Binary<float, Safe, true>([](float lhs, float rhs) { return lhs * rhs; });
+        
+        case OpCodes::mulsb:
+            return cpu.Binary<uchar_t, Safe, true>([](uchar_t lhs, uchar_t rhs) { return lhs * rhs; });
 
-        return exc.GetCode();, 
-        return System::ErrorCode::UnhandledException;
-    )
+        default:
+            return Error::InvalidInstruction;
+    }
 }
 
-OPR CPU::DivStack(CPU& cpu) noexcept
+OPR CPU::DivRegister(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        System::ErrorCode err;
+    OpCodes op { ins.op };
+    RegisterModeFlags reg1 { ins.reg1 };
+    RegisterModeFlags reg2 { ins.reg2 };
 
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1))) 
+    switch (op) 
+    {
+        case OpCodes::divri:
         {
-            case OpCodes::divi:
-            {
-                if (cpu.state.sp < 4)
-                    return System::ErrorCode::RAMAccessError;
-
-                sysbit_t lhs { IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data
-                )};
-                sysbit_t rhs { IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data
-                )};
-
-                err = cpu.PopSome(8);
-                if (err != System::ErrorCode::Ok)
-                    return err;
-
-                sysbit_t res { lhs / rhs };
-                char* bytes { BytesFromInteger<sysbit_t>(res) };
-                err = cpu.PushSome({bytes, 4});
-                delete[] bytes;
-
-                return err;
-            }
-
-            case OpCodes::divf:
-            {
-                if (cpu.state.sp < 4)
-                    return System::ErrorCode::RAMAccessError;
-
-                float lhs { FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data) };
-                float rhs { FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data) };
-
-                err = cpu.PopSome(8);
-                if (err != System::ErrorCode::Ok)
-                    return err;
-
-                float res { lhs / rhs };
-                char* bytes { BytesFromFloat(res) };
-                err = cpu.PushSome({bytes, 4});
-                delete[] bytes;
+            sysbit_t lhs { GetRegister32Bit(reg1, cpu.state) };
+            sysbit_t& rhs { GetRegister32Bit(reg2, cpu.state) };
+            rhs = lhs / rhs;
+            break;
+        }
 
-                return err;
-            }
+        case OpCodes::divrf:
+        {
+            float lhs { std::bit_cast<float>(GetRegister32Bit(reg1, cpu.state)) };
             
-            case OpCodes::divb:
-            {
-                uchar_t lhs { static_cast<uchar_t>(cpu.board.ram.Read(cpu.state.sp-2)) };
-                uchar_t rhs { static_cast<uchar_t>(cpu.board.ram.Read(cpu.state.sp-1)) };
+            float rhs { std::bit_cast<float>(GetRegister32Bit(reg2, cpu.state)) };
 
-                err = cpu.PopSome(2);
-                if (err != System::ErrorCode::Ok)
-                    return err;
+            GetRegister32Bit(reg2, cpu.state) = std::bit_cast<sysbit_t>(lhs / rhs);
 
-                uchar_t res { static_cast<uchar_t>(lhs / rhs) };
-                err = cpu.Push(res);
-                return err;
-            }
+            break;
+        }
+        
+        case OpCodes::divrb:
+        {
+            uchar_t lhs { GetRegister8Bit(reg1, cpu.state) };
+            uchar_t& rhs { GetRegister8Bit(reg2, cpu.state) };
+            rhs = lhs / rhs;
+            break;
+        }
 
-            default:
-                return Error::InvalidInstruction;
-        }, 
+        default:
+            return Error::InvalidInstruction;
+    }
 
-        return exc.GetCode();, 
-        return System::ErrorCode::UnhandledException;
-    )
+    return Error::Ok;
 }
 
-OPR CPU::DivSafe(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::DivStack(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        System::ErrorCode err;
-
-        switch (OpCodes(cpu.board.assembly.Rom().Read(cpu.state.pc-1))) 
-        {
-            case OpCodes::divsi:
-            {
-                if (cpu.state.sp < 4)
-                    return System::ErrorCode::RAMAccessError;
-
-                sysbit_t lhs { IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data
-                )};
-                sysbit_t rhs { IntegerFromBytes<sysbit_t>(
-                    cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data
-                )};
-
-                sysbit_t res { lhs / rhs };
-                char* bytes { BytesFromInteger<sysbit_t>(res) };
-                err = cpu.PushSome({bytes, 4});
-                delete[] bytes;
-
-                return err;
-            }
-
-            case OpCodes::divsf:
-            {
-                if (cpu.state.sp < 4)
-                    return System::ErrorCode::RAMAccessError;
-
-                float lhs { FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data) };
-                float rhs { FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data) };
+    switch (ins.op) 
+    {
+        case OpCodes::divi:
+            return cpu.Binary<sysbit_t, Safe>([](sysbit_t lhs, sysbit_t rhs) { return lhs / rhs; });
 
-                float res { lhs / rhs };
-                char* bytes { BytesFromFloat(res) };
-                err = cpu.PushSome({bytes, 4});
-                delete[] bytes;
+        case OpCodes::divf:
+            return cpu.Binary<float, Safe>([](float lhs, float rhs) { return lhs / rhs; });
+        
+        case OpCodes::divb:
+            return cpu.Binary<uchar_t, Safe>([](uchar_t lhs, uchar_t rhs) { return lhs / rhs; });
 
-                return err;
-            }
-            
-            case OpCodes::divsb:
-            {
-                uchar_t lhs { static_cast<uchar_t>(cpu.board.ram.Read(cpu.state.sp-2)) };
-                uchar_t rhs { static_cast<uchar_t>(cpu.board.ram.Read(cpu.state.sp-1)) };
+        default:
+            return Error::InvalidInstruction;
+    }
+}
 
-                uchar_t res { static_cast<uchar_t>(lhs / rhs) };
-                err = cpu.Push(res);
-                return err;
-            }
+template<bool Safe>
+OPR CPU::DivSafe(CPU& cpu, const Instruction& ins) noexcept
+{
+    switch (ins.op) 
+    {
+        case OpCodes::divsi:
+            return cpu.Binary<sysbit_t, Safe, true>([](sysbit_t lhs, sysbit_t rhs) { return lhs / rhs; });
 
-            default:
-                return Error::InvalidInstruction;
-        }, 
+        case OpCodes::divsf:
+            return cpu.Binary<float, Safe, true>([](float lhs, float rhs) { return lhs / rhs; });
+        
+        case OpCodes::divsb:
+            return cpu.Binary<uchar_t, Safe, true>([](uchar_t lhs, uchar_t rhs) { return lhs / rhs; });
 
-        return exc.GetCode();, 
-        return System::ErrorCode::UnhandledException;
-    )
+        default:
+            return Error::InvalidInstruction;
+    }
 }
 
-OPR CPU::Return(CPU& cpu) noexcept
+OPR CPU::Return(CPU& cpu, const Instruction& ins) noexcept
 { 
     // callstack is:
     //  bp 4bytes
@@ -2790,21 +1936,21 @@ OPR CPU::Return(CPU& cpu) noexcept
     if (cpu.state.sp - cpu.state.bp < cpu.state.bl)
         return System::ErrorCode::StackUnderflow;
 
-    sysbit_t bpToReturnTo { IntegerFromBytes<sysbit_t>(
-        cpu.board.ram.ReadSome(cpu.state.bp - 8, 4).data
+    ReadSomeChecked(bpToReturnToData, cpu.state.bp - 8, 4)
+    sysbit_t bpToReturnTo { IntegerFromRam<sysbit_t>(
+        bpToReturnToData
     )};
-    sysbit_t pcToReturnTo { IntegerFromBytes<sysbit_t>(
-        cpu.board.ram.ReadSome(cpu.state.bp - 4, 4).data
+    ReadSomeChecked(pcToReturnToData, cpu.state.bp - 4, 4)
+    sysbit_t pcToReturnTo { IntegerFromRam<sysbit_t>(
+        pcToReturnToData
     )};
 
-    System::ErrorCode err;
+    System::ErrorCode err { System::ErrorCode::Ok };
     
     if (cpu.state.bl != 0)
     {
-        Slice returnValues { cpu.board.ram.ReadSome(
-            cpu.state.sp - cpu.state.bl,
-            cpu.state.bl
-        )};
+        ReadSomeChecked(returnValuesData, cpu.state.sp - cpu.state.bl, cpu.state.bl)
+        Slice returnValues { returnValuesData, cpu.state.bl };
         cpu.PopSome(cpu.state.sp - cpu.state.bp + 8);
         cpu.PushSome(returnValues);
     }
@@ -2817,215 +1963,164 @@ OPR CPU::Return(CPU& cpu) noexcept
     return err;
 }
 
-OPR CPU::Deallocate(CPU& cpu) noexcept
+OPR CPU::Deallocate(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        if (cpu.state.ebx < 0 || cpu.board.ram.Size() <= cpu.state.ebx)
-            return System::ErrorCode::RAMAccessError;
+    if (!cpu.board.ram.Contains(cpu.state.ebx, 0))
+        return System::ErrorCode::RAMAccessError;
 
-        Error err { cpu.board.ram.Deallocate(cpu.state.ebx, cpu.state.ecx) };
-        return err;,
-        
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    Error err { cpu.board.ram.Deallocate(cpu.state.ebx, cpu.state.ecx) };
+    if (err == System::ErrorCode::Ok && cpu.board.profile != nullptr)
+        cpu.board.profile->Freed(cpu.state.ebx, cpu.state.ecx);
+    return err;
 }
 
-OPR CPU::Sub32(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::Sub32(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        sysbit_t rhs;
-        sysbit_t lhs;
-        rhs = IntegerFromBytes<sysbit_t>(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data);
-        cpu.PopSome(4);
-        lhs = IntegerFromBytes<sysbit_t>(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data);
-        cpu.PopSome(4);
-
-        char* data { BytesFromInteger(lhs-rhs) };
-        Error err { cpu.PushSome({
-            data,
-            4
-        })};
-
-        delete[] data;
-        return err;,
-
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    return cpu.Binary<sysbit_t, Safe>([](sysbit_t lhs, sysbit_t rhs) { return lhs-rhs; });
 }
 
-OPR CPU::SubFloat(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::SubFloat(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        float rhs;
-        float lhs;
-        rhs = FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data);
-        cpu.PopSome(4);
-        lhs = FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data);
-        cpu.PopSome(4);
-
-        char* data { BytesFromFloat<char>(lhs-rhs) };
-        Error err { cpu.PushSome({
-            data,
-            4
-        })};
-
-        delete[] data;
-        return err;,
-
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    return cpu.Binary<float, Safe>([](float lhs, float rhs) { return lhs-rhs; });
 }
 
-OPR CPU::Sub8(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::Sub8(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        uchar_t rhs;
-        uchar_t lhs;
-        rhs = cpu.board.ram.Read(cpu.state.sp-1);
-        cpu.Pop();
-        lhs = cpu.board.ram.Read(cpu.state.sp-1);
-        cpu.Pop();
-        
-        Error err { cpu.Push(lhs-rhs) };
-        return err;,
-
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    return cpu.Binary<uchar_t, Safe>([](uchar_t lhs, uchar_t rhs) { return lhs-rhs; });
 }
 
-OPR CPU::SubReg(CPU& cpu) noexcept
+OPR CPU::SubReg(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        OpCodes op { cpu.board.assembly.Rom().Read(cpu.state.pc-1) };
-        RegisterModeFlags regLhs { cpu.board.assembly.Rom().Read(cpu.state.pc) };
-        RegisterModeFlags regRhs { cpu.board.assembly.Rom().Read(cpu.state.pc+1) };
-        
-        if (
-            /*case 1*/ 
-            ((op == OpCodes::subrb)
-            &&
-            (!Is8BitReg(regLhs) || !Is8BitReg(regRhs)))
-            ||
-
-            /*case 2*/
-            ((op != OpCodes::subrb)
-            &&
-            (Is8BitReg(regLhs) || Is8BitReg(regRhs)))
-        )
-            CRASH(System::ErrorCode::InvalidSpecifier,
-                "In ", cpu.board.Stringify(), ", PC: ", std::to_string(cpu.state.pc-1),
-                " ", OpCodesString(op),
-                " ", RegisterModeFlagsString(regLhs),
-                " ", RegisterModeFlagsString(regRhs),
-                " Given registers are not compatible with given numeric type."
-            );
-
-        cpu.state.pc+=2;
-
-        if (Is8BitReg(regLhs))
-        {
-            uchar_t regLhsRef { GetRegister8Bit(regLhs, cpu.state) };
-            uchar_t& regRhsRef { GetRegister8Bit(regRhs, cpu.state) };
-            regRhsRef = regLhsRef - regRhsRef;
-        }
-        else if (op == OpCodes::subrf)
-        {
-            sysbit_t regLhsRef { GetRegister32Bit(regLhs, cpu.state) };
-            sysbit_t& regRhsRef { GetRegister32Bit(regRhs, cpu.state) };
+    OpCodes op { ins.op };
+    RegisterModeFlags regLhs { ins.reg1 };
+    RegisterModeFlags regRhs { ins.reg2 };
+    
+    // register widths were checked against the opcode when decoded
+    if (Is8BitReg(regLhs))
+    {
+        uchar_t regLhsRef { GetRegister8Bit(regLhs, cpu.state) };
+        uchar_t& regRhsRef { GetRegister8Bit(regRhs, cpu.state) };
+        regRhsRef = regLhsRef - regRhsRef;
+    }
+    else if (op == OpCodes::subrf)
+    {
+        sysbit_t regLhsRef { GetRegister32Bit(regLhs, cpu.state) };
+        sysbit_t& regRhsRef { GetRegister32Bit(regRhs, cpu.state) };
 
-            char* data { BytesFromInteger(regLhsRef) };
-            float floatLhs { FloatFromBytes(
-                data
-            )};
-            delete[] data;
+        float floatLhs { std::bit_cast<float>(regLhsRef)};
 
-            data = BytesFromInteger(regRhsRef);
-            float floatRhs { FloatFromBytes(
-                data
-            )};
-            delete[] data;
+        float floatRhs { std::bit_cast<float>(regRhsRef)};
 
-            data = BytesFromFloat(floatLhs-floatRhs);
-            regRhsRef = IntegerFromBytes<sysbit_t>(
-                data
-            );
-            delete[] data;
-        }
-        else
-        {
-            sysbit_t regLhsRef { GetRegister32Bit(regLhs, cpu.state) };
-            sysbit_t& regRhsRef { GetRegister32Bit(regRhs, cpu.state) };
-            regRhsRef = regLhsRef - regRhsRef;
-        }
+        regRhsRef = std::bit_cast<sysbit_t>(floatLhs-floatRhs);
+    }
+    else
+    {
+        sysbit_t regLhsRef { GetRegister32Bit(regLhs, cpu.state) };
+        sysbit_t& regRhsRef { GetRegister32Bit(regRhs, cpu.state) };
+        regRhsRef = regLhsRef - regRhsRef;
+    }
 
-        return System::ErrorCode::Ok;,
+    return System::ErrorCode::Ok;
+}
 
-        return exc.GetCode();,
-        return Error::UnhandledException;
-    )
+template<bool Safe>
+OPR CPU::SubSafe32(CPU& cpu, const Instruction& ins) noexcept
+{
+    return cpu.Binary<sysbit_t, Safe, true>([](sysbit_t lhs, sysbit_t rhs) { return lhs-rhs; });
 }
 
-OPR CPU::SubSafe32(CPU& cpu) noexcept
+template<bool Safe>
+OPR CPU::SubSafeFloat(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        sysbit_t rhs;
-        sysbit_t lhs;
-        rhs = IntegerFromBytes<sysbit_t>(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data);
-        lhs = IntegerFromBytes<sysbit_t>(cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data);
+    return cpu.Binary<float, Safe, true>([](float lhs, float rhs) { return lhs-rhs; });
+}
 
-        char* data { BytesFromInteger(lhs-rhs) };
-        Error err { cpu.PushSome({
-            data,
-            4
-        })};
-        delete[] data;
+template<bool Safe>
+OPR CPU::SubSafe8(CPU& cpu, const Instruction& ins) noexcept
+{
+    return cpu.Binary<uchar_t, Safe, true>([](uchar_t lhs, uchar_t rhs) { return lhs-rhs; });
+}
 
-        return err;,
+//
+// Superinstructions
+//
+OPR CPU::FoldedConstant(CPU& cpu, const Instruction& ins) noexcept
+{
+    // stt a, stt b, add/sub/mul
+    // result was computed when fused, the sequence needs room for both
+    // operands though.
+    if (cpu.state.sp+8 > cpu.board.ram.StackSize())
+        return System::ErrorCode::StackOverflow;
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    // imm is laid out the way RAM holds it
+    return cpu.PushU32<false>(RamOrder(ins.imm));
 }
 
-OPR CPU::SubSafeFloat(CPU& cpu) noexcept
+OPR CPU::CompareJump(CPU& cpu, const Instruction& ins) noexcept
 {
-    try_catch(
-        float rhs;
-        float lhs;
-        rhs = FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-4, 4).data);
-        lhs = FloatFromBytes(cpu.board.ram.ReadSome(cpu.state.sp-8, 4).data);
+    // cmp <mode>, pop..., cnd <address>
+    System::ErrorCode err { Compare(cpu, ins) };
+    if (err != System::ErrorCode::Ok)
+        return err;
 
-        char* data { BytesFromFloat<char>(lhs-rhs) };
-        Error err { cpu.PushSome({
-            data,
-            4
-        })};
-        delete[] data;
+    if (ins.imm2 != 0)
+    {
+        err = cpu.PopSome(ins.imm2);
+        if (err != System::ErrorCode::Ok)
+            return err;
+    }
 
-        return err;,
+    // not taken, pc already points past the cnd
+    if (cpu.state.bl == 0)
+        return System::ErrorCode::Ok;
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
-}
+    sysbit_t address { ins.imm };
 
-OPR CPU::SubSafe8(CPU& cpu) noexcept
-{
-    try_catch(
-        uchar_t rhs;
-        uchar_t lhs;
-        rhs = cpu.board.ram.Read(cpu.state.sp-1);
-        lhs = cpu.board.ram.Read(cpu.state.sp-2);
-        
-        Error err { cpu.Push(lhs-rhs) };
-        return err;,
+    // Safety test, address must be in bounds of rom
+    RomSafetyCheck(address);
+    if (address <= ins.pc)
+        Heat(ins.target);
 
-        return exc.GetCode();,
-        return System::ErrorCode::UnhandledException;
-    )
+    cpu.state.pc = address;
+    cpu.ip = ins.target;
+    return System::ErrorCode::Ok;
 }
+
+OPR CPU::SysCallPrologue(CPU& cpu, const Instruction& ins) noexcept
+{
+    // incrb &flg <mode>, movc &bl <imm2>, cal <imm>
+    cpu.state.flg += ins.mode;
+    cpu.state.bl = static_cast<uchar_t>(ins.imm2);
+    return CallFunc(cpu, ins);
+}
+
+// Both flavours of the stack handlers, CPU::operations holds the checked
+// ones and CPU::RunBurst picks per run.
+#define Instantiate(name) \
+        template Error CPU::name<true>(CPU& cpu, const Instruction& ins) noexcept; \
+        template Error CPU::name<false>(CPU& cpu, const Instruction& ins) noexcept;
+Instantiate(StoreThirtyTwo) Instantiate(StoreEight) Instantiate(StoreFromSymbol)
+Instantiate(LoadFromStack)
+Instantiate(Add32) Instantiate(AddFloat) Instantiate(Add8)
+Instantiate(AddSafe32) Instantiate(AddSafeFloat) Instantiate(AddSafe8)
+Instantiate(Increment) Instantiate(IncrementSafe)
+Instantiate(Decrement) Instantiate(DecrementSafe)
+Instantiate(SwapTop)
+Instantiate(DuplicateTop)
+Instantiate(RawDataStack)
+Instantiate(Invert) Instantiate(InvertSafe)
+Instantiate(Compare)
+Instantiate(PopInstruction)
+Instantiate(Jump)
+Instantiate(PowStack) Instantiate(PowConst)
+Instantiate(SqrtStack) Instantiate(SqrtConst)
+Instantiate(ConditionalJump)
+Instantiate(MulStack) Instantiate(MulSafe)
+Instantiate(DivStack) Instantiate(DivSafe)
+Instantiate(Sub32) Instantiate(SubFloat) Instantiate(Sub8)
+Instantiate(SubSafe32) Instantiate(SubSafeFloat) Instantiate(SubSafe8)
+#undef Instantiate
 #undef OPR
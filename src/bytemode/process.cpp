@@ -1,4 +1,4 @@
-#include <memory>
+#include <algorithm>
 #include <sstream>
 #include <string>
 
@@ -14,6 +14,11 @@
 //
 // Process Implementation
 //
+Process::Process(Board& parent, uchar_t id) : board(parent), id(id)
+{
+    this->SetQuantum(VM::GetVM().GetSettings().quantum);
+}
+
 const std::string& Process::Stringify() const noexcept
 {
     if (this->reprStr.size() != 0)
@@ -26,26 +31,6 @@ const std::string& Process::Stringify() const noexcept
     return reprStr;
 }
 
-Error SendShutdown(Process& process)
-{
-    std::unique_ptr<char[]> data { new char[2] };
-    data[0] = process.id;
-    data[1] = 1;
-
-    System::ErrorCode code { process.SendMessage({
-        MessageType::PtoB, 
-        rval(data)
-    })};
-
-    if (code != System::ErrorCode::Ok)
-        LOGE(
-            System::LogLevel::Medium,
-            "In ", process.Stringify(), " error while sending Shutdown signal to board."
-        );
-    
-    return code;
-}
-
 Error Process::Cycle() noexcept
 {
     System::ErrorCode code { this->DispatchMessages() };
@@ -57,35 +42,37 @@ Error Process::Cycle() noexcept
             " error while dispatching messages. Error code: ", System::ErrorCodeString(code)
         );
 
-    // Send Shutdown signal to board
+    // Ran off the end, the board removes it
     if (this->board.cpu.DumpState().pc >= this->board.assembly.Rom().Size())
-        return SendShutdown(*this);
-
-    OpCodes op { this->board.Assembly().Rom()[this->board.cpu.DumpState().pc] };
-
-    // New callStack will be initialized, or destroyed
-    // either way that means it's interrupt for this process.
-    // Send message to Board to switch to the next process.
-    // Switch signal
-    if (op == OpCodes::cal || op == OpCodes::calr || op == OpCodes::ret)
     {
-        std::unique_ptr<char[]> data { std::make_unique_for_overwrite<char[]>(2) };
-        data[0] = this->id;
-        data[1] = 0;
-        this->SendMessage({MessageType::PtoB, rval(data)});
+        this->board.request = Board::Request::Exit;
+        return System::ErrorCode::Ok;
     }
 
-    code = this->board.cpu.Cycle();
+    // Run a burst, cut short where the quantum ends
+    sysbit_t budget { std::min(VM::GetVM().GetSettings().burst, this->left) };
+    const sysbit_t start { budget };
+    code = this->board.cpu.RunBurst(budget);
 
     if (code == Error::Ok)
+    {
+        this->left -= start-budget;
+        if (this->left != 0)
+            return code;
+
+        // Quantum's up, the board switches to the next runnable process
+        this->left = this->quantum;
+        this->board.request = Board::Request::Switch;
         return code;
+    }
 
     LOGE(
         System::LogLevel::Medium,
         "In ", this->Stringify(),
         " error in CPU cycle. Error code: ", System::ErrorCodeString(code)
     );
-    return SendShutdown(*this);
+    this->board.request = Board::Request::Exit;
+    return System::ErrorCode::Ok;
 }
 
 //
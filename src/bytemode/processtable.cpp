@@ -0,0 +1,52 @@
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#include "bytemode/process.hpp"
+#include "bytemode/processtable.hpp"
+#include "CSRConfig.hpp"
+
+//
+// ProcessTable Implementation
+//
+sysbit_t ProcessTable::FreeId() const noexcept
+{
+    for (sysbit_t word = 0; word < this->used.size(); word++)
+        if (this->used[word] != ~std::uint64_t { 0 })
+            return word*64 + static_cast<sysbit_t>(std::countr_one(this->used[word]));
+
+    return Capacity;
+}
+
+Process& ProcessTable::Emplace(const uchar_t id, const uchar_t before, Board& board)
+{
+    Slot& slot { this->slots[id] };
+    slot.process.emplace(board, id);
+
+    if (this->count == 0)
+        slot.next = slot.prev = id;
+    else
+    {
+        Slot& after { this->slots[before] };
+        slot.next = before;
+        slot.prev = after.prev;
+        this->slots[after.prev].next = id;
+        after.prev = id;
+    }
+
+    this->used[id/64] |= std::uint64_t { 1 } << (id%64);
+    this->count++;
+    return *slot.process;
+}
+
+void ProcessTable::Erase(const uchar_t id) noexcept
+{
+    Slot& slot { this->slots[id] };
+    this->slots[slot.prev].next = slot.next;
+    this->slots[slot.next].prev = slot.prev;
+    slot.next = slot.prev = id;
+    slot.process.reset();
+
+    this->used[id/64] &= ~(std::uint64_t { 1 } << (id%64));
+    this->count--;
+}
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bytemode/profile.hpp"
+#include "bytemode/ram.hpp"
+#include "CSRConfig.hpp"
+#include "system.hpp"
+
+//
+// Profile Implementation
+//
+void Profile::Allocated(const RAM& ram, const sysbit_t pc, const sysbit_t address, const sysbit_t size)
+{
+    // what's left of a block partly freed at the same address is gone now
+    if (const auto stale { this->blocks.find(address) }; stale != this->blocks.end())
+    {
+        Site& site { this->sites[stale->second.pc] };
+        site.liveBlocks--;
+        site.liveBytes -= stale->second.size;
+    }
+
+    Site& site { this->sites[pc] };
+    site.blocks++;
+    site.bytes += size;
+    site.liveBlocks++;
+    site.liveBytes += size;
+
+    this->blocks[address] = { pc, size };
+    this->heapPeak = std::max(this->heapPeak, ram.HeapUsed());
+}
+
+void Profile::Failed(const sysbit_t pc)
+{
+    this->sites[pc].failed++;
+}
+
+void Profile::Freed(const sysbit_t address, const sysbit_t size)
+{
+    this->frees++;
+
+    // A block lives on until a del covers all of it, same as with --handles
+    const std::uint64_t end { std::uint64_t{address}+size };
+    auto block { this->blocks.lower_bound(address) };
+    while (block != this->blocks.end() && block->first+std::uint64_t{block->second.size} <= end)
+    {
+        Site& site { this->sites[block->second.pc] };
+        site.liveBlocks--;
+        site.liveBytes -= block->second.size;
+        block = this->blocks.erase(block);
+    }
+}
+
+void Profile::Dump(const std::string& name, const RAM& ram) const
+{
+    const sysbit_t used { ram.HeapUsed() };
+    const sysbit_t free { ram.HeapSize()-used };
+    const sysbit_t largest { ram.LargestFree() };
+
+    // 0 when the free cells are one run, towards 1 the more they're split up
+    std::stringstream fragmentation;
+    fragmentation.precision(2);
+    fragmentation << std::fixed << (free == 0 ? 0.0 : 1.0-static_cast<double>(largest)/free);
+
+    LOG(
+        name, " stack: ", std::to_string(this->stackPeak), " of ",
+        std::to_string(ram.StackSize()), " bytes at peak."
+    );
+    LOG(
+        name, " heap: ", std::to_string(used), " of ", std::to_string(ram.HeapSize()),
+        " bytes live (", std::to_string(ram.HeapLimit()), " max), ",
+        std::to_string(this->heapPeak), " at peak, ", std::to_string(this->frees), " del."
+    );
+    LOG(
+        name, " heap: largest free run ", std::to_string(largest),
+        " bytes, fragmentation ", fragmentation.str(), "."
+    );
+
+    // the sites holding the most memory first
+    std::vector<std::pair<sysbit_t, Site>> sorted { this->sites.begin(), this->sites.end() };
+    std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) {
+        if (lhs.second.liveBytes != rhs.second.liveBytes)
+            return lhs.second.liveBytes > rhs.second.liveBytes;
+        return lhs.second.bytes > rhs.second.bytes;
+    });
+
+    for (const auto& [pc, site] : sorted)
+        LOG(
+            name, " alc at ", std::to_string(pc), ": ",
+            std::to_string(site.blocks), " blocks, ", std::to_string(site.bytes), " bytes, ",
+            std::to_string(site.liveBlocks), " live (", std::to_string(site.liveBytes), " bytes), ",
+            std::to_string(site.failed), " failed."
+        );
+}
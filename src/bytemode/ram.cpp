@@ -1,137 +1,356 @@
 #include "CSRConfig.hpp"
 #include "extensions/syntaxextensions.hpp"
 #include "bytemode/board.hpp"
+#include "bytemode/bulk.hpp"
+#include "platform.hpp"
 #include "system.hpp"
+#include <algorithm>
 #include <bitset>
 #include <cassert>
+#include <cstring>
+#include <limits>
 #include <string>
 #include "bytemode/ram.hpp"
 
+namespace
+{
+    std::size_t RoundUp(const std::size_t size, const std::size_t page) noexcept
+    { return (size+page-1)/page*page; }
+}
+
 //
 // RAM Implementation
 //
-char RAM::Read(const sysbit_t address) const
+RAM::RAM(sysbit_t stackSize, sysbit_t heapSize, sysbit_t heapLimit, Paging paging, bool handled, Budget& budget, const Board& board) :
+    heap(heapSize),
+    stackSize(stackSize),
+    heapSize(heapSize),
+    // addresses are 32 bits wide
+    heapLimit(std::min(std::max(heapSize, heapLimit), std::numeric_limits<sysbit_t>::max()-stackSize)),
+    paging(paging),
+    budget(&budget),
+    handled(handled),
+    board(board)
 {
-    if (address >= (this->stackSize+this->heapSize) || address < 0)
+    if (handled)
+        this->handles = Handles { (std::uint64_t{1} << 32)-stackSize };
+
+    const std::size_t page { PageSize() };
+    const std::size_t reserved { std::max(page, RoundUp(std::size_t{stackSize}+this->heapLimit, page)) };
+
+    this->data = { static_cast<char*>(MemReserve(reserved)), Release { reserved } };
+    if (this->data != nullptr && paging.hugePages)
+        MemHugePages(this->data.get(), reserved);
+    // before anything is backed, so every page lands there
+    if (this->data != nullptr && paging.node >= 0)
+        MemBindNode(this->data.get(), reserved, paging.node, false);
+
+    if (this->data == nullptr || !this->Commit(Footprint(stackSize, heapSize)))
         CRASH(
-            System::ErrorCode::RAMAccessError, 
-            "Error in ", this->board.Stringify(),
-            " Attempt to read out of bounds memory ", std::to_string(address)
+            Error::Bad,
+            "Can't reserve ", std::to_string(reserved), " bytes of memory for ", board.Stringify()
         );
-    
-    return this->data[address];
 }
 
-const Slice RAM::ReadSome(const sysbit_t address, const sysbit_t size) const
+RAM::RAM(const Image& image, Budget& budget, const Board& board) :
+    heap(image.heap),
+    stackSize(image.source.stackSize),
+    heapSize(image.source.heapSize),
+    heapLimit(image.source.heapLimit),
+    paging(image.source.paging),
+    budget(&budget),
+    handles(image.source.handles),
+    handled(image.source.handled),
+    board(board)
 {
-    if (address >= (this->stackSize+this->heapSize) || address < 0 || (address+size) > this->stackSize+this->heapSize)
-        CRASH(
-            System::ErrorCode::RAMAccessError, 
-            "Error in ", this->board.Stringify(),
-            " Attempt to read out of bounds memory ", std::to_string(address)
-        );
+    const RAM& source { image.source };
+    const std::size_t reserved { source.data.get_deleter().size };
+
+    this->data = { static_cast<char*>(MemReserve(reserved)), Release { reserved } };
+    if (this->data != nullptr && this->paging.hugePages)
+        MemHugePages(this->data.get(), reserved);
+
+    // Share the image's pages, or copy them where there's no snapshot.
+    // Shared pages are charged in full, any of them can become private.
+    if (this->data != nullptr && budget.Charge(source.committed))
+    {
+        if (MemMapSnapshot(image.snapshot, this->data.get(), source.committed))
+            this->committed = source.committed;
+        else
+            budget.Release(source.committed);
+    }
+
+    if (this->committed != source.committed)
+    {
+        if (this->data == nullptr || !this->Commit(source.committed))
+            CRASH(
+                Error::Bad,
+                "Can't reserve ", std::to_string(reserved), " bytes of memory for ", board.Stringify()
+            );
+        Bulk::Copy(this->data.get(), source.data.get(), source.Size());
+    }
+
+    // Mapping the snapshot replaced the reservation's policy. Pages the
+    // clone writes become its own and go on the node.
+    if (this->paging.node >= 0)
+        MemBindNode(this->data.get(), reserved, this->paging.node, false);
+}
+
+std::size_t RAM::Footprint(const sysbit_t stackSize, const sysbit_t heapSize) noexcept
+{
+    return RoundUp(std::size_t{stackSize}+heapSize, PageSize());
+}
 
-    return {
-        this->data.get()+address,
-        size
-    };}
+RAM::Image::Image(const RAM& source) noexcept :
+    source(source),
+    snapshot(MemSnapshot(source.data.get(), source.committed)),
+    heap(source.heap)
+{ }
+
+RAM::Image::~Image()
+{
+    MemDropSnapshot(this->snapshot);
+}
+
+void RAM::Release::operator()(char* data) const noexcept
+{
+    MemRelease(data, this->size);
+}
+
+Error RAM::Read(const sysbit_t address, char& value) const noexcept
+{
+    const char* const at { this->Locate(address, 1) };
+    if (at == nullptr)
+        return System::ErrorCode::RAMAccessError;
+
+    value = *at;
+    return System::ErrorCode::Ok;
+}
+
+Error RAM::ReadSome(const sysbit_t address, const sysbit_t size, const char*& data) const noexcept
+{
+    data = this->Locate(address, size);
+    if (data == nullptr)
+        return System::ErrorCode::RAMAccessError;
+    return System::ErrorCode::Ok;
+}
 
 Error RAM::Write(const sysbit_t address, char value) noexcept
 {
-    if (address >= (this->stackSize+this->heapSize) || address < 0)
+    char* const at { this->Locate(address, 1) };
+    if (at == nullptr)
         return System::ErrorCode::RAMAccessError;
-    this->data[address] = value; 
+
+    *at = value;
     return System::ErrorCode::Ok;
 }
 
 Error RAM::WriteSome(const sysbit_t address, const Slice values) noexcept
 {
-    if (address >= (this->stackSize+this->heapSize) || address < 0 || (address+values.size) > this->stackSize+this->heapSize)
-    {
-        LOGE(
-            System::LogLevel::Medium, 
-            "Error in ", this->board.Stringify(),
-            ". Attempt to write to out of bounds memory ",
-            std::to_string(address)
-        );
+    char* const at { this->Locate(address, values.size) };
+    if (at == nullptr)
+        return this->WriteError(address);
+
+    // values may point into RAM itself
+    Bulk::Copy(at, values.data, values.size);
+    return System::ErrorCode::Ok;
+}
+
+Error RAM::Copy(const sysbit_t to, const sysbit_t from, const sysbit_t size) noexcept
+{
+    // reads don't log, same as ReadSome
+    const char* const source { this->Locate(from, size) };
+    if (source == nullptr)
         return System::ErrorCode::RAMAccessError;
-    }
+    char* const target { this->Locate(to, size) };
+    if (target == nullptr)
+        return this->WriteError(to);
 
-    System::ErrorCode status { System::ErrorCode::Ok };
-    for(sysbit_t i = 0; i < values.size; i++)
-    {
-        status = this->Write(address+i, values[i]);
+    Bulk::Copy(target, source, size);
+    return System::ErrorCode::Ok;
+}
 
-        if (status != System::ErrorCode::Ok)
-        {
-            LOGE(
-                System::LogLevel::Medium,
-                "Error in ",
-                this->board.Stringify(), 
-                ". Can't write to RAM address ", std::to_string(address),
-                ". Error code: ", System::ErrorCodeString(status)
-            );
-            break;
-        }
-            
-    }
+Error RAM::Fill(const sysbit_t address, const Slice pattern, const sysbit_t count) noexcept
+{
+    if (count == 0)
+        return System::ErrorCode::Ok;
+
+    char* const at { this->Locate(address, std::uint64_t{pattern.size}*count) };
+    if (at == nullptr)
+        return this->WriteError(address);
 
-    return status;
+    Bulk::Fill(at, pattern.data, pattern.size, count);
+    return System::ErrorCode::Ok;
 }
 
-sysbit_t RAM::Allocate(sysbit_t size)
+Error RAM::Swap(const sysbit_t lhs, const sysbit_t rhs, const sysbit_t size) noexcept
 {
-    sysbit_t counter { size };
-    sysbit_t allocationAddr { 0 };
-    bool set = false;
+    char* const left { this->Locate(lhs, size) };
+    if (left == nullptr)
+        return this->WriteError(lhs);
+    char* const right { this->Locate(rhs, size) };
+    if (right == nullptr)
+        return this->WriteError(rhs);
 
-    for (sysbit_t i = this->StackSize(); i < this->Size(); i++)
-    {
-        if (counter == 0)
-            break;
+    Bulk::Swap(left, right, size);
+    return System::ErrorCode::Ok;
+}
+
+char* RAM::Locate(const sysbit_t address, const std::uint64_t size) const noexcept
+{
+    if (!this->handled)
+        return this->InBounds(address, size) ? this->data.get()+address : nullptr;
 
-        const sysbit_t reali { i - this->StackSize() };
-        const sysbit_t index { reali/8 };
-        const uchar_t offset { static_cast<uchar_t>(reali - (index*8)) };
-        const bool isAvailable { ((this->allocationMap[index] >> (7-offset)) & 1) == 0 }; 
+    if (address < this->stackSize)
+        return size <= this->stackSize-address ? this->data.get()+address : nullptr;
+
+    sysbit_t slot, into;
+    if (!this->handles.Resolve(address-this->stackSize, size, slot, into))
+        return nullptr;
+    return this->data.get()+this->stackSize+this->handles[slot].offset+into;
+}
+
+Error RAM::WriteError(const sysbit_t address) const noexcept
+{
+    LOGE(
+        System::LogLevel::Medium, 
+        "Error in ", this->board.Stringify(),
+        ". Attempt to write to out of bounds memory ",
+        std::to_string(address)
+    );
+    return System::ErrorCode::RAMAccessError;
+}
+
+Error RAM::Allocate(sysbit_t size, sysbit_t& address) noexcept
+{
+    // first fit, else make one run out of the free cells, else grow
+    sysbit_t offset;
+    const bool placed {
+        this->heap.Allocate(size, offset)
+        || (size != 0 && this->Compact(size) && this->heap.Allocate(size, offset))
+        || (size != 0 && this->Grow(size) && this->heap.Allocate(size, offset))
+    };
 
-        if (!isAvailable)
+    if (placed && !this->handled)
+    {
+        address = this->stackSize+offset;
+        return System::ErrorCode::Ok;
+    }
+
+    if (placed)
+    {
+        sysbit_t handle;
+        if (this->handles.Add(offset, size, handle))
         {
-            counter = size;
-            allocationAddr = 0;
-            set = false;
-            continue;
+            address = this->stackSize+handle;
+            return System::ErrorCode::Ok;
         }
 
-        allocationAddr = set ? allocationAddr : i;
-        counter--;
-        set = true;
-    }
-    if (counter != 0)
-        CRASH(
-            System::ErrorCode::HeapOverflow,
+        this->heap.Free(offset, size);
+        LOGE(
+            System::LogLevel::Medium,
             "Can't allocate memory of size ", std::to_string(size),
-            " bytes from ", this->board.Stringify(), ". Board is out of memory."
+            " bytes from ", this->board.Stringify(), ". Board is out of handles."
         );
-    else if (!set)
-        CRASH(
-            System::ErrorCode::FragmentedHeap,
+        return System::ErrorCode::HeapOverflow;
+    }
+
+    if (size != 0 && size > this->heap.FreeCells())
+    {
+        LOGE(
+            System::LogLevel::Medium,
             "Can't allocate memory of size ", std::to_string(size),
-            " bytes from ", this->board.Stringify(), ". No suitable fragment found on heap."
+            " bytes from ", this->board.Stringify(), ". Board is out of memory."
         );
-    for (sysbit_t i = allocationAddr - this->StackSize(); size > 0; i++, size--)
+        return System::ErrorCode::HeapOverflow;
+    }
+
+    LOGE(
+        System::LogLevel::Medium,
+        "Can't allocate memory of size ", std::to_string(size),
+        " bytes from ", this->board.Stringify(), ". No suitable fragment found on heap."
+    );
+    return System::ErrorCode::FragmentedHeap;
+}
+
+bool RAM::Grow(const sysbit_t size) noexcept
+{
+    // the run ends at the heap's end, what's free there already counts
+    const std::uint64_t needed { std::uint64_t{this->heapSize}+size-this->heap.FreeTail() };
+    if (needed > this->heapLimit)
+        return false;
+
+    // At least double so a growing heap isn't rebuilt on every alc, and
+    // back whole pages since they're committed anyway.
+    const std::uint64_t wanted { std::max<std::uint64_t>(needed, std::uint64_t{this->heapSize}*2) };
+    const std::size_t end {
+        std::min(RoundUp(this->stackSize+wanted, PageSize()), this->data.get_deleter().size)
+    };
+    const sysbit_t grown { static_cast<sysbit_t>(std::min<std::uint64_t>(end-this->stackSize, this->heapLimit)) };
+
+    if (!this->Commit(end))
+        return false;
+
+    this->heap.Grow(grown);
+    this->heapSize = grown;
+    return true;
+}
+
+bool RAM::Compact(const sysbit_t size) noexcept
+{
+    if (!this->handled || size > this->heap.FreeCells())
+        return false;
+
+    char* const cells { this->data.get()+this->stackSize };
+    sysbit_t end { 0 };
+    sysbit_t to { 0 };
+    for (const sysbit_t slot : this->handles.ByOffset())
     {
-        const sysbit_t index { i/8 }; 
-        const uchar_t offset { static_cast<uchar_t>(i - (index*8)) };
-        this->allocationMap[index] |= (uchar_t{1} << (7-offset));
+        Handles::Block& block { this->handles[slot] };
+        end = block.offset+block.size;
+        Bulk::Copy(cells+to, cells+block.offset, block.size);
+        block.offset = to;
+        to += block.size;
     }
 
-    return allocationAddr;
+    // free cells read as zero
+    Bulk::Zero(cells+to, end-to);
+
+    // Only whole blocks are ever freed with handles, so the blocks are
+    // all the heap has in use.
+    this->heap = Heap(this->heapSize);
+    sysbit_t offset;
+    if (to != 0)
+        this->heap.Allocate(to, offset);
+    return true;
+}
+
+bool RAM::Commit(const std::size_t end) noexcept
+{
+    if (end <= this->committed)
+        return true;
+
+    if (this->budget != nullptr && !this->budget->Charge(end-this->committed))
+        return false;
+
+    char* const from { this->data.get()+this->committed };
+    if (!MemCommit(from, end-this->committed))
+    {
+        if (this->budget != nullptr)
+            this->budget->Release(end-this->committed);
+        return false;
+    }
+    if (this->paging.prefault)
+        MemPrefault(from, end-this->committed);
+
+    this->committed = end;
+    return true;
 }
 
 Error RAM::Deallocate(const sysbit_t address, const sysbit_t size) noexcept
 {
-    if (address >= (this->stackSize+this->heapSize) || address < 0 || (address+size) > this->stackSize+this->heapSize)
+    char* const at { this->Locate(address, size) };
+    if (at == nullptr)
     {
         LOGE(
             System::LogLevel::Medium, 
@@ -140,25 +359,57 @@ Error RAM::Deallocate(const sysbit_t address, const sysbit_t size) noexcept
         );
         return System::ErrorCode::RAMAccessError;
     }
-        
 
-    for (sysbit_t i = address; i < address+size; i++)
+    Bulk::Zero(at, size);
+
+    // a block goes back to the heap once all of it is freed
+    if (this->handled)
     {
-        const sysbit_t index { i/8 };
-        const uchar_t offset { static_cast<uchar_t>(i - (index*8)) };
-        this->allocationMap[index] &= ~(uchar_t{1} << (7-offset));
-        this->data[i] = 0;
+        sysbit_t slot, into;
+        if (
+            address >= this->stackSize
+            && this->handles.Resolve(address-this->stackSize, size, slot, into)
+            && into == 0 && size == this->handles[slot].size
+        )
+        {
+            this->heap.Free(this->handles[slot].offset, size);
+            this->handles.Remove(slot);
+        }
+        return System::ErrorCode::Ok;
     }
 
+    // only the part on the heap has cells to free
+    const sysbit_t from { std::max(address, this->stackSize)-this->stackSize };
+    const sysbit_t to { address+size > this->stackSize ? address+size-this->stackSize : 0 };
+    if (from < to)
+        this->heap.Free(from, to-from);
+
     return System::ErrorCode::Ok;
 }
 
+bool RAM::Migrate(const int node) noexcept
+{
+    if (this->data == nullptr || node < 0 || node >= NumaNodes())
+        return false;
+    if (!MemBindNode(this->data.get(), this->data.get_deleter().size, node, true))
+        return false;
+
+    this->paging.node = node;
+    return true;
+}
+
 RAM& RAM::operator=(RAM&& other)
 {
     this->stackSize = other.stackSize;
     this->heapSize = other.heapSize;
+    this->heapLimit = other.heapLimit;
+    this->committed = other.committed;
+    this->paging = other.paging;
+    this->budget = other.budget;
+    this->handles = rval(other.handles);
+    this->handled = other.handled;
     this->data = rval(other.data);
-    this->allocationMap = rval(other.allocationMap);
+    this->heap = rval(other.heap);
 
     return *this;
 }
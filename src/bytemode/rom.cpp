@@ -34,15 +34,13 @@ const char* ROM::operator&() const
     return this->operator&(0); 
 }
 
-const Slice ROM::ReadSome(const sysbit_t index, const sysbit_t size) const
+Error ROM::ReadSome(const sysbit_t index, const sysbit_t size, const char*& data) const noexcept
 {
     if (index >= this->size || index < 0 || (index + size) > this->size)
-        CRASH(System::ErrorCode::ROMAccessError, "Index '", std::to_string(index), "' of ROM is invalid.");
+        return System::ErrorCode::ROMAccessError;
 
-    return {
-        this->data.get()+index,
-        size
-    };
+    data = this->data.get()+index;
+    return System::ErrorCode::Ok;
 }
 
 Error ROM::TryRead(const sysbit_t index, char& data, const std::function<void()> failAct) const noexcept
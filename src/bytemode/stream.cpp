@@ -0,0 +1,613 @@
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+#include "extensions/converters.hpp"
+#include "bytemode/instructions.hpp"
+#include "bytemode/stream.hpp"
+#include "bytemode/cpu.hpp"
+#include "bytemode/rom.hpp"
+#include "bytemode/syscall.hpp"
+#include "CSRConfig.hpp"
+#include "system.hpp"
+
+//
+// InstructionStream Implementation
+//
+void InstructionStream::DecodeAt(sysbit_t pc, Instruction& ins) const noexcept
+{
+    // Instructions that can never execute successfully are decoded into
+    // a Fault, which reports the error once it is reached.
+    const auto MakeFault { [](Instruction& ins, System::ErrorCode code) {
+        ins.handler = CPU::Fault;
+        ins.imm = static_cast<sysbit_t>(code);
+        ins.dispatch = Instruction::Yield;
+    }};
+
+    const char* rom { this->rom.Data().data };
+    const sysbit_t size { this->rom.Size() };
+
+    ins = Instruction { };
+    ins.pc = pc;
+    ins.next = pc;
+    ins.follow = npos;
+    ins.target = npos;
+
+    if (pc >= size)
+    {
+        MakeFault(ins, System::ErrorCode::ROMAccessError);
+        return;
+    }
+
+    const uchar_t opByte { static_cast<uchar_t>(rom[pc]) };
+    if (opByte >= std::size(CPU::operations))
+    {
+        // keep the raw byte around for the error message
+        MakeFault(ins, System::ErrorCode::InvalidInstruction);
+        ins.mode = opByte;
+        ins.next = pc+1;
+        ins.follow = this->Locate(ins.next);
+        return;
+    }
+
+    ins.op = OpCodes(opByte);
+    ins.handler = CPU::operations[opByte];
+
+    sysbit_t cursor { pc+1 };
+    bool truncated { false };
+
+    const auto skip { [&](sysbit_t count) -> const char* {
+        if (size - cursor < count)
+        {
+            truncated = true;
+            cursor = size;
+            return rom+size-1;
+        }
+        cursor += count;
+        return rom+cursor-count;
+    }};
+    const auto byte { [&]() -> uchar_t {
+        return static_cast<uchar_t>(*skip(1));
+    }};
+    const auto word { [&]() -> sysbit_t {
+        const char* at { skip(4) };
+        return truncated ? 0 : IntegerFromBytes<sysbit_t>(at);
+    }};
+    // register operands are validated here once, handlers access them
+    // without checking
+    bool badRegister { false };
+    const auto reg { [&]() -> uchar_t {
+        const uchar_t value { byte() };
+        if (value < Enumc(RegisterModeFlags::eax) || value > Enumc(RegisterModeFlags::flg))
+            badRegister = true;
+        return value;
+    }};
+    const auto romRange { [&](sysbit_t address, sysbit_t count) -> bool {
+        return address < size && count <= size - address;
+    }};
+
+    switch (ins.op)
+    {
+        case OpCodes::stt:
+            ins.data = skip(4);
+            break;
+
+        case OpCodes::ste:
+            ins.data = skip(1);
+            break;
+
+        case OpCodes::stts:
+        case OpCodes::stes:
+        {
+            ins.imm = word();
+            const sysbit_t count { ins.op == OpCodes::stes ? sysbit_t{1} : sysbit_t{4} };
+            if (!truncated && !romRange(ins.imm, count))
+                MakeFault(ins, System::ErrorCode::ROMAccessError);
+            else
+                ins.data = rom+ins.imm;
+            break;
+        }
+
+        case OpCodes::rdr: case OpCodes::movs:
+        case OpCodes::andst: case OpCodes::andse:
+        case OpCodes::orst: case OpCodes::orse:
+        case OpCodes::norst: case OpCodes::norse:
+        case OpCodes::invr:
+        case OpCodes::jmpr:
+        case OpCodes::sqrri: case OpCodes::sqrrf: case OpCodes::sqrrb:
+        case OpCodes::cndr:
+        case OpCodes::calr:
+            ins.reg1 = reg();
+            break;
+
+        case OpCodes::movc:
+            ins.reg1 = reg();
+            ins.imm = Is8BitReg(ins.reg1) ? byte() : word();
+            break;
+
+        case OpCodes::movr:
+        case OpCodes::addri: case OpCodes::addrf: case OpCodes::addrb:
+        case OpCodes::andr: case OpCodes::orr: case OpCodes::norr:
+        case OpCodes::swpr:
+        case OpCodes::powri: case OpCodes::powrf: case OpCodes::powrb:
+        case OpCodes::mulri: case OpCodes::mulrf: case OpCodes::mulrb:
+        case OpCodes::divri: case OpCodes::divrf: case OpCodes::divrb:
+        case OpCodes::subri: case OpCodes::subrf: case OpCodes::subrb:
+            ins.reg1 = reg();
+            ins.reg2 = reg();
+            break;
+
+        case OpCodes::mcp:
+        case OpCodes::cmp:
+            ins.mode = byte();
+            break;
+
+        case OpCodes::cmpr:
+            ins.mode = byte();
+            ins.reg1 = reg();
+            ins.reg2 = reg();
+            break;
+
+        case OpCodes::inci: case OpCodes::incf:
+        case OpCodes::incsi: case OpCodes::incsf:
+        case OpCodes::dcri: case OpCodes::dcrf:
+        case OpCodes::dcrsi: case OpCodes::dcrsf:
+        case OpCodes::jmp:
+        case OpCodes::swr: case OpCodes::dur:
+        case OpCodes::sqri: case OpCodes::sqrf:
+        case OpCodes::cnd:
+        case OpCodes::cal:
+            ins.imm = word();
+            break;
+
+        case OpCodes::incb: case OpCodes::incsb:
+        case OpCodes::dcrb: case OpCodes::dcrsb:
+        case OpCodes::sqrb:
+            ins.imm = byte();
+            break;
+
+        case OpCodes::incri: case OpCodes::incrf:
+        case OpCodes::dcrri: case OpCodes::dcrrf:
+            ins.reg1 = reg();
+            ins.imm = word();
+            break;
+
+        case OpCodes::incrb:
+        case OpCodes::dcrrb:
+            ins.reg1 = reg();
+            ins.imm = byte();
+            break;
+
+        case OpCodes::raw:
+            ins.imm = word();
+            ins.data = skip(ins.imm);
+            break;
+
+        case OpCodes::raws:
+            ins.imm = word();
+            ins.imm2 = word();
+            if (!truncated && !romRange(ins.imm, ins.imm2))
+                MakeFault(ins, System::ErrorCode::ROMAccessError);
+            else
+                ins.data = rom+ins.imm;
+            break;
+
+        case OpCodes::rep:
+        {
+            ins.mode = byte();
+            ins.imm = word();
+            const NumericModeFlags numMode { NumericModeFlags(ins.mode & 0b00001111) };
+            ins.data = skip(ByteSize(numMode));
+            break;
+        }
+
+        case OpCodes::powi:
+        case OpCodes::powf:
+            ins.imm = word();
+            ins.imm2 = word();
+            break;
+
+        case OpCodes::powb:
+            ins.imm = byte();
+            ins.imm2 = byte();
+            break;
+
+        default:
+            break;
+    }
+
+    // Handlers that don't branch on the register width take it from the
+    // opcode, the operands must match it.
+    const bool wide1 { !(Is8BitReg(ins.reg1)) };
+    const bool wide2 { !(Is8BitReg(ins.reg2)) };
+    switch (ins.op)
+    {
+        case OpCodes::jmpr: case OpCodes::cndr: case OpCodes::calr:
+        case OpCodes::incri: case OpCodes::incrf:
+        case OpCodes::dcrri: case OpCodes::dcrrf:
+        case OpCodes::sqrri: case OpCodes::sqrrf:
+            badRegister |= !wide1;
+            break;
+
+        case OpCodes::incrb: case OpCodes::dcrrb:
+        case OpCodes::sqrrb:
+            badRegister |= wide1;
+            break;
+
+        case OpCodes::addri: case OpCodes::addrf:
+        case OpCodes::powri: case OpCodes::powrf:
+        case OpCodes::mulri: case OpCodes::mulrf:
+        case OpCodes::divri: case OpCodes::divrf:
+        case OpCodes::subri: case OpCodes::subrf:
+            badRegister |= !wide1 || !wide2;
+            break;
+
+        case OpCodes::addrb: case OpCodes::powrb:
+        case OpCodes::mulrb: case OpCodes::divrb:
+        case OpCodes::subrb:
+            badRegister |= wide1 || wide2;
+            break;
+
+        default:
+            break;
+    }
+
+    if (truncated)
+    {
+        MakeFault(ins, System::ErrorCode::ROMAccessError);
+        ins.data = nullptr;
+    }
+    else if (badRegister)
+        MakeFault(ins, System::ErrorCode::InvalidSpecifier);
+
+    ins.next = cursor;
+    ins.follow = this->Locate(ins.next);
+
+    // Calls and returns are scheduling points, a burst must hand them back
+    // to the Process. Anything that names pc as a register may move it.
+    const uchar_t pcReg { Enumc(RegisterModeFlags::pc) };
+    if (ins.handler == CPU::Fault)
+        ins.dispatch = Instruction::Yield;
+    else if (ins.op == OpCodes::cal || ins.op == OpCodes::calr || ins.op == OpCodes::ret)
+        ins.dispatch = Instruction::Yield;
+    else if (ins.reg1 == pcReg || ins.reg2 == pcReg)
+        ins.dispatch = Instruction::Generic;
+    else
+        ins.dispatch = Enumc(ins.op);
+
+    if (ins.op == OpCodes::jmp || ins.op == OpCodes::cnd || ins.op == OpCodes::cal)
+        ins.target = this->Locate(ins.imm);
+}
+
+Error InstructionStream::Decode() noexcept
+{
+    const sysbit_t size { this->rom.Size() };
+
+    this->instructions.clear();
+    this->offsets.assign(static_cast<size_t>(size)+1, npos);
+
+    // first 12 bytes are the header, body starts right after
+    if (size < 12)
+        return System::ErrorCode::ROMAccessError;
+
+    for (sysbit_t pc = 12; pc < size; )
+    {
+        Instruction ins;
+        this->DecodeAt(pc, ins);
+
+        this->offsets[pc] = this->Size();
+        this->instructions.push_back(ins);
+        pc = ins.next;
+    }
+
+    // sentinel at the end of the ROM, processes shut down before
+    // ever executing it.
+    Instruction end;
+    this->DecodeAt(size, end);
+    this->offsets[size] = this->Size();
+    this->instructions.push_back(end);
+
+    // Link fallthroughs and static targets now that every
+    // instruction start is known.
+    for (Instruction& ins : this->instructions)
+    {
+        ins.follow = ins.next == ins.pc ? npos : this->Locate(ins.next);
+
+        if (ins.handler == CPU::Fault)
+            continue;
+
+        if (ins.op == OpCodes::jmp || ins.op == OpCodes::cnd || ins.op == OpCodes::cal)
+            ins.target = this->Locate(ins.imm);
+    }
+
+    return System::ErrorCode::Ok;
+}
+
+void InstructionStream::Fuse() noexcept
+{
+    std::vector<Instruction>& code { this->instructions };
+
+    // The last one is the sentinel, nothing starts there.
+    const sysbit_t end { this->Size()-1 };
+
+    const auto Is { [&](sysbit_t i, OpCodes op) {
+        return i < end && code[i].handler != CPU::Fault && code[i].op == op;
+    }};
+
+    // stt a, stt b, (add|sub|mul)(i|f)
+    // Both operands are constants, fold them into a single push.
+    const auto FoldConstant { [&](sysbit_t i) -> bool {
+        if (!Is(i, OpCodes::stt) || !Is(i+1, OpCodes::stt) || i+2 >= end)
+            return false;
+
+        const Instruction& arith { code[i+2] };
+        if (arith.handler == CPU::Fault)
+            return false;
+
+        const sysbit_t lhs { IntegerFromBytes<sysbit_t>(code[i].data) };
+        const sysbit_t rhs { IntegerFromBytes<sysbit_t>(code[i+1].data) };
+        const float lhsf { FloatFromBytes(code[i].data) };
+        const float rhsf { FloatFromBytes(code[i+1].data) };
+
+        sysbit_t result;
+        switch (arith.op)
+        {
+            case OpCodes::addi: result = lhs+rhs; break;
+            case OpCodes::subi: result = lhs-rhs; break;
+            case OpCodes::muli: result = lhs*rhs; break;
+            case OpCodes::addf: result = std::bit_cast<sysbit_t>(lhsf+rhsf); break;
+            case OpCodes::subf: result = std::bit_cast<sysbit_t>(lhsf-rhsf); break;
+            case OpCodes::mulf: result = std::bit_cast<sysbit_t>(lhsf*rhsf); break;
+            default: return false;
+        }
+
+        Instruction& head { code[i] };
+
+        // imm holds the result the way it's laid out in RAM
+        IntegerToRam(result, reinterpret_cast<char*>(&head.imm));
+
+        head.handler = CPU::FoldedConstant;
+        head.dispatch = Instruction::Generic;
+        head.next = arith.next;
+        head.follow = arith.follow;
+        this->fusions.foldedConstants++;
+        return true;
+    }};
+
+    // cmp, pop..., cnd
+    // Pops in between are common since cmp leaves its operands behind.
+    const auto CompareJump { [&](sysbit_t i) -> bool {
+        if (!Is(i, OpCodes::cmp))
+            return false;
+
+        sysbit_t j { i+1 };
+        sysbit_t popped { 0 };
+        for (; Is(j, OpCodes::popt) || Is(j, OpCodes::pope); j++)
+            popped += code[j].op == OpCodes::popt ? 4 : 1;
+
+        if (!Is(j, OpCodes::cnd))
+            return false;
+
+        Instruction& head { code[i] };
+        head.handler = CPU::CompareJump;
+        head.dispatch = Instruction::Generic;
+        head.imm = code[j].imm;
+        head.imm2 = popped;
+        head.target = code[j].target;
+        head.next = code[j].next;
+        head.follow = code[j].follow;
+        this->fusions.compareJumps++;
+        return true;
+    }};
+
+    // incrb &flg <n>, movc &bl <size>, cal <id>
+    // The call is a scheduling point, so is the fused instruction.
+    const auto SysCallPrologue { [&](sysbit_t i) -> bool {
+        if (
+            !Is(i, OpCodes::incrb) || code[i].reg1 != Enumc(RegisterModeFlags::flg)
+            || !Is(i+1, OpCodes::movc) || code[i+1].reg1 != Enumc(RegisterModeFlags::bl)
+            || !Is(i+2, OpCodes::cal)
+        )
+            return false;
+
+        Instruction fused { code[i+2] };
+        fused.pc = code[i].pc;
+        fused.handler = CPU::SysCallPrologue;
+        fused.mode = static_cast<uchar_t>(code[i].imm);
+        fused.imm2 = code[i+1].imm;
+
+        code[i] = fused;
+        this->fusions.sysCallPrologues++;
+        return true;
+    }};
+
+    for (sysbit_t i = 0; i < end; i++)
+        if (!FoldConstant(i) && !CompareJump(i))
+            SysCallPrologue(i);
+}
+
+// What a single instruction does to the stack. `need` is how many bytes it
+// reads below sp, `pop` and `push` how far it then moves sp down and up.
+// False if that depends on anything but the instruction itself.
+static bool StackEffect(const Instruction& ins, sysbit_t& need, sysbit_t& pop, sysbit_t& push) noexcept
+{
+    using Op = OpCodes;
+
+    need = pop = push = 0;
+
+    if (ins.dispatch == Instruction::Generic || ins.dispatch == Instruction::Yield)
+        return false;
+
+    // register operands that move the stack itself
+    const auto stackReg { [](uchar_t reg) {
+        return reg == Enumc(RegisterModeFlags::sp) || reg == Enumc(RegisterModeFlags::bp);
+    }};
+    if (stackReg(ins.reg1) || stackReg(ins.reg2))
+        return false;
+
+    const sysbit_t width { Is8BitReg(ins.reg1) ? sysbit_t{1} : sysbit_t{4} };
+    const auto Set { [&](sysbit_t n, sysbit_t o, sysbit_t u) {
+        need = n; pop = o; push = u;
+        return true;
+    }};
+
+    switch (ins.op)
+    {
+        case Op::stt: case Op::stts:
+        case Op::powi: case Op::powf:
+        case Op::sqri: case Op::sqrf:
+            return Set(0, 0, 4);
+        case Op::ste: case Op::stes:
+        case Op::powb: case Op::sqrb:
+            return Set(0, 0, 1);
+
+        case Op::ldt: case Op::inci: case Op::incf: case Op::dcri: case Op::dcrf:
+            return Set(4, 0, 0);
+        case Op::lde: case Op::incb: case Op::dcrb:
+            return Set(1, 0, 0);
+
+        case Op::rdt: return Set(0, 0, 4);
+        case Op::rde: return Set(0, 0, 1);
+        case Op::rdr: return Set(0, 0, width);
+        case Op::movs: return Set(width, 0, 0);
+
+        case Op::addi: case Op::addf: case Op::subi: case Op::subf:
+        case Op::muli: case Op::mulf: case Op::divi: case Op::divf:
+        case Op::powsi: case Op::powsf:
+            return Set(8, 8, 4);
+        case Op::addb: case Op::subb: case Op::mulb: case Op::divb:
+        case Op::powsb:
+            return Set(2, 2, 1);
+
+        case Op::addsi: case Op::addsf: case Op::subsi: case Op::subsf:
+        case Op::mulsi: case Op::mulsf: case Op::divsi: case Op::divsf:
+            return Set(8, 0, 4);
+        case Op::addsb: case Op::subsb: case Op::mulsb: case Op::divsb:
+            return Set(2, 0, 1);
+
+        case Op::incsi: case Op::incsf: case Op::dcrsi: case Op::dcrsf:
+        case Op::dupt: case Op::invst:
+            return Set(4, 0, 4);
+        case Op::incsb: case Op::dcrsb:
+        case Op::dupe: case Op::invse:
+            return Set(1, 0, 1);
+
+        case Op::andst: case Op::orst: case Op::norst: case Op::swpt:
+            return Set(8, 0, 0);
+        case Op::andse: case Op::orse: case Op::norse: case Op::swpe:
+            return Set(2, 0, 0);
+
+        case Op::invt: case Op::sqrsi: case Op::sqrsf:
+            return Set(4, 4, 4);
+        case Op::inve: case Op::sqrsb:
+            return Set(1, 1, 1);
+
+        case Op::cmp:
+        {
+            const NumericModeFlags numMode { static_cast<char>(ins.mode >> 5) };
+            return Set(2*ByteSize(numMode), 0, 0);
+        }
+
+        case Op::popt: return Set(4, 4, 0);
+        case Op::pope: return Set(1, 1, 0);
+
+        case Op::raw: return Set(0, 0, ins.imm);
+        case Op::raws: return Set(0, 0, ins.imm2);
+
+        case Op::nop:
+        case Op::movc: case Op::movr:
+        case Op::addri: case Op::addrf: case Op::addrb:
+        case Op::subri: case Op::subrf: case Op::subrb:
+        case Op::mulri: case Op::mulrf: case Op::mulrb:
+        case Op::divri: case Op::divrf: case Op::divrb:
+        case Op::powri: case Op::powrf: case Op::powrb:
+        case Op::sqrri: case Op::sqrrf: case Op::sqrrb:
+        case Op::incri: case Op::incrf: case Op::incrb:
+        case Op::dcrri: case Op::dcrrf: case Op::dcrrb:
+        case Op::andr: case Op::orr: case Op::norr:
+        case Op::swpr: case Op::invr: case Op::cmpr:
+        case Op::mcp: case Op::alc: case Op::del:
+        case Op::jmp: case Op::jmpr: case Op::cnd: case Op::cndr:
+            return true;
+
+        // swr, dur and rep take their sizes from registers, calls and
+        // returns switch frames.
+        default:
+            return false;
+    }
+}
+
+void InstructionStream::Verify() noexcept
+{
+    std::vector<Instruction>& code { this->instructions };
+    constexpr sysbit_t unproven { Instruction::Unproven };
+
+    this->verification = VerifyCounts { };
+
+    // Summaries only ever look forward along the fallthrough, walking
+    // backwards has every follow ready by the time it's needed.
+    const sysbit_t end { this->Size()-1 };
+    for (sysbit_t i = end; i-- > 0; )
+    {
+        Instruction& ins { code[i] };
+        ins.chained = false;
+        ins.stackNeed = unproven;
+        ins.stackGrow = 0;
+
+        if (ins.handler == CPU::Fault)
+            continue;
+
+        // cal may name a syscall instead, calls run checked either way
+        const bool branch { ins.op == OpCodes::jmp || ins.op == OpCodes::cnd };
+        if (branch && ins.target == npos)
+        {
+            this->verification.badTargets++;
+            continue;
+        }
+
+        sysbit_t need, pop, push;
+        if (!StackEffect(ins, need, pop, push))
+        {
+            // runs checked, the next run is looked at once this one is done
+            ins.stackNeed = 0;
+            continue;
+        }
+
+        this->verification.proven++;
+
+        std::int64_t runNeed { std::max(need, pop) };
+        std::int64_t runGrow { push > pop ? push-pop : 0 };
+
+        // Jumps end a run, wherever they land is checked on arrival.
+        const bool jumps {
+            ins.op == OpCodes::jmp || ins.op == OpCodes::jmpr
+            || ins.op == OpCodes::cnd || ins.op == OpCodes::cndr
+        };
+        if (!jumps && ins.follow != npos && ins.follow > i && code[ins.follow].stackNeed != unproven)
+        {
+            const Instruction& next { code[ins.follow] };
+            const std::int64_t delta { static_cast<std::int64_t>(push) - static_cast<std::int64_t>(pop) };
+
+            const std::int64_t chainNeed { std::max(runNeed, next.stackNeed - delta) };
+            const std::int64_t chainGrow { std::max(runGrow, delta + next.stackGrow) };
+            if (chainNeed < unproven && chainGrow < unproven)
+            {
+                runNeed = chainNeed;
+                runGrow = std::max<std::int64_t>(chainGrow, 0);
+                ins.chained = true;
+            }
+        }
+
+        ins.stackNeed = static_cast<sysbit_t>(runNeed);
+        ins.stackGrow = static_cast<sysbit_t>(runGrow);
+    }
+}
+
+void InstructionStream::Link(class SysCallHandler& syscalls)
+{
+    for (Instruction& ins : this->instructions)
+        if (ins.op == OpCodes::cal && ins.handler != CPU::Fault)
+            ins.slot = syscalls.Slot(ins.imm);
+}
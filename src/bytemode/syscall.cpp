@@ -27,7 +27,10 @@ char SysCallHandler::BindFunction(sysbit_t id, SysFunctionHandler handler) noexc
     if (boundFuncs.contains(id))
         return (char)Error::DuplicateSysBind;
 
-    boundFuncs[id] = rval(handler);
+    boundFuncs[id] = handler;
+
+    if (const auto slot { slotIds.find(id) }; slot != slotIds.end())
+        slots[slot->second] = handler;
     return (char)Error::Ok;
 }
 
@@ -36,17 +39,32 @@ char SysCallHandler::UnbindFunction(sysbit_t id) noexcept
     if (!boundFuncs.contains(id))
         return (char)Error::InvalidKey;
     boundFuncs.erase(id);
+
+    if (const auto slot { slotIds.find(id) }; slot != slotIds.end())
+        slots[slot->second] = nullptr;
     return (char)Error::Ok;
 }
 
 const SysFunctionHandler& SysCallHandler::operator[](sysbit_t id) const
 {
-    if (!boundFuncs.contains(id))
+    const SysFunctionMap::const_iterator found { boundFuncs.find(id) };
+    if (found == boundFuncs.end())
         CRASH(
             Error::InvalidKey,
             "Error while syscall, no handler with key ", std::to_string(id), "."
         ); 
-    return boundFuncs.at(id);
+    return found->second;
+}
+
+sysbit_t SysCallHandler::Slot(sysbit_t id)
+{
+    if (const auto slot { slotIds.find(id) }; slot != slotIds.end())
+        return slot->second;
+
+    const sysbit_t slot { static_cast<sysbit_t>(slots.size()) };
+    slots.push_back(this->Find(id));
+    slotIds.emplace(id, slot);
+    return slot;
 }
 
 dlID_t SysCallHandler::LoadDl(std::string_view dllPath) 
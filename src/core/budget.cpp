@@ -0,0 +1,46 @@
+#include <atomic>
+#include <cstdint>
+
+#include "budget.hpp"
+
+//
+// Budget Implementation
+//
+Budget::~Budget()
+{
+    if (this->parent != nullptr)
+        this->parent->Release(this->Used());
+}
+
+bool Budget::Charge(const std::uint64_t bytes) noexcept
+{
+    const std::uint64_t before { this->used.fetch_add(bytes, std::memory_order_relaxed) };
+    if (this->limit != 0 && before+bytes > this->limit)
+    {
+        this->used.fetch_sub(bytes, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (this->parent != nullptr && !this->parent->Charge(bytes))
+    {
+        this->used.fetch_sub(bytes, std::memory_order_relaxed);
+        return false;
+    }
+
+    return true;
+}
+
+void Budget::Release(const std::uint64_t bytes) noexcept
+{
+    this->used.fetch_sub(bytes, std::memory_order_relaxed);
+    if (this->parent != nullptr)
+        this->parent->Release(bytes);
+}
+
+bool Budget::Fits(const std::uint64_t bytes) const noexcept
+{
+    for (const Budget* budget = this; budget != nullptr; budget = budget->parent)
+        if (budget->limit != 0 && budget->Used()+bytes > budget->limit)
+            return false;
+    return true;
+}
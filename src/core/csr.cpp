@@ -1,4 +1,6 @@
 #include <cassert>
+#include <charconv>
+#include <cstdint>
 #include <exception>
 #include <filesystem>
 #include <iostream>
@@ -29,9 +31,38 @@ int csrmain(int argc, char** args)
             if (flags.GetFlag<CLIParser::FlagType::Bool>("no-new"))
                 LOGW("Single-process runtime is currently unavailable. A new instance will be created.");
 
+            const int burst { flags.GetFlag<CLIParser::FlagType::Int>("burst") };
+            const int quantum { flags.GetFlag<CLIParser::FlagType::Int>("quantum") };
+            const int maxHeap { flags.GetFlag<CLIParser::FlagType::Int>("max-heap") };
+            const int clones { flags.GetFlag<CLIParser::FlagType::Int>("clones") };
+            const int cloneAt { flags.GetFlag<CLIParser::FlagType::Int>("clone-at") };
+            const int threads { flags.GetFlag<CLIParser::FlagType::Int>("threads") };
+#ifdef ENABLE_JIT
+            const int hot { flags.GetFlag<CLIParser::FlagType::Int>("hot") };
+#endif
+
             VM::GetVM().Setup({
                 .strictMessages = !flags.GetFlag<CLIParser::FlagType::Bool>("no-strict-messages"),
                 .unsafe = flags.GetFlag<CLIParser::FlagType::Bool>("unsafe"),
+                .burst = burst > 0 ? static_cast<sysbit_t>(burst) : 1024,
+                .quantum = quantum > 0 ? static_cast<sysbit_t>(quantum) : 4096,
+                .stats = flags.GetFlag<CLIParser::FlagType::Bool>("stats"),
+                .verified = flags.GetFlag<CLIParser::FlagType::Bool>("verified"),
+                .maxHeap = maxHeap > 0 ? static_cast<sysbit_t>(maxHeap) : 0,
+                .prefault = flags.GetFlag<CLIParser::FlagType::Bool>("prefault"),
+                .hugePages = flags.GetFlag<CLIParser::FlagType::Bool>("huge-pages"),
+                .threads = threads > 0 ? static_cast<sysbit_t>(threads) : 1,
+                .numa = flags.GetFlag<CLIParser::FlagType::Bool>("numa"),
+                .handles = flags.GetFlag<CLIParser::FlagType::Bool>("handles"),
+                .profile = flags.GetFlag<CLIParser::FlagType::Bool>("profile"),
+                .boardMemory = ParseBytes("board-memory", flags.GetFlag<CLIParser::FlagType::String>("board-memory")),
+                .assemblyMemory = ParseBytes("assembly-memory", flags.GetFlag<CLIParser::FlagType::String>("assembly-memory")),
+                .vmMemory = ParseBytes("vm-memory", flags.GetFlag<CLIParser::FlagType::String>("vm-memory")),
+                .clones = clones > 0 ? static_cast<sysbit_t>(clones) : 0,
+                .cloneAt = cloneAt > 0 ? static_cast<sysbit_t>(cloneAt) : 0,
+#ifdef ENABLE_JIT
+                .hotness = hot > 0 ? static_cast<sysbit_t>(hot) : 64,
+#endif
 #ifndef NDEBUG
                 .step = flags.GetFlag<CLIParser::FlagType::Bool>("step"),
 #endif
@@ -72,6 +103,9 @@ int csrmain(int argc, char** args)
                     case System::ErrorCode::UnsupportedFileType:
                         LOGE(System::LogLevel::Medium, "Couldn't open assembly '", file.generic_string(), "'.");
                         break;
+                    case System::ErrorCode::MemoryOverflow:
+                        LOGE(System::LogLevel::Medium, "Can't register assembly '", file.filename().generic_string(), "', it doesn't fit in the memory budget.");
+                        break;
                     case System::ErrorCode::Ok:
                         break;
                     default:
@@ -134,6 +168,7 @@ CLIParser::Flags SetUpCLI(char** args, int argc)
     parser.Separator();
 #ifdef ENABLE_JIT
     parser.AddFlag<FlagType::Bool>("jit", "Mark this execution as JIT target.");
+    parser.AddFlag<FlagType::Int>("hot", "Calls or back-edges into code before the JIT translates it. Defaults to 64.");
 #endif
     parser.AddFlag<FlagType::Bool>("no-new", "Do not create a new instance of CSR, use an already running one.");
     parser.AddFlag<FlagType::Bool>("no-strict-messages", "Don't strictly verify messages in each checkpoint when dispatching.", true);
@@ -141,6 +176,22 @@ CLIParser::Flags SetUpCLI(char** args, int argc)
     parser.AddFlag<FlagType::StringList>("exe", "Executable files to execute.");
     parser.Separator();
     parser.AddFlag<FlagType::Bool>("unsafe", "Load extender dll of each executable.");
+    parser.AddFlag<FlagType::Int>("burst", "Max instructions a process runs in one go before yielding to its board. Defaults to 1024.");
+    parser.AddFlag<FlagType::Int>("quantum", "Instructions a process runs before its board switches to the next one. Defaults to 4096.");
+    parser.AddFlag<FlagType::Bool>("stats", "Print what the runtime did to each assembly while loading and running it.");
+    parser.AddFlag<FlagType::Bool>("verified", "Skip stack and jump checks for code the load-time verifier could prove safe.");
+    parser.AddFlag<FlagType::Int>("max-heap", "Bytes each board's heap may grow to on demand. Defaults to the size in the executable's header.");
+    parser.AddFlag<FlagType::Bool>("prefault", "Fault board RAM in up front instead of on first touch.");
+    parser.AddFlag<FlagType::Bool>("huge-pages", "Ask for transparent huge pages for board RAM.");
+    parser.AddFlag<FlagType::Int>("threads", "Worker threads running the boards, stealing work from each other. Defaults to 1.");
+    parser.AddFlag<FlagType::Bool>("numa", "Keep each board's RAM on the NUMA node of the thread running it.");
+    parser.AddFlag<FlagType::Bool>("handles", "Hand out heap blocks as handles and compact the heap instead of failing on fragmentation.");
+    parser.AddFlag<FlagType::Bool>("profile", "Print each board's stack and heap usage and allocation sites when it exits or on SIGUSR1.");
+    parser.AddFlag<FlagType::String>("board-memory", "Memory each board may hold, in bytes or with a K, M or G suffix. No cap by default.");
+    parser.AddFlag<FlagType::String>("assembly-memory", "Memory each executable and its boards may hold, same units as --board-memory.");
+    parser.AddFlag<FlagType::String>("vm-memory", "Memory all executables together may hold, same units as --board-memory.");
+    parser.AddFlag<FlagType::Int>("clones", "Boards to clone off each executable's first board, see --clone-at.");
+    parser.AddFlag<FlagType::Int>("clone-at", "ROM address of the scheduling point (cal, calr, ret) where the first board is cloned. Defaults to the entry point.");
 #ifndef NDEBUG
     parser.Separator();
     parser.AddFlag<FlagType::Bool>("step", "Run the VM once every input.");
@@ -157,3 +208,27 @@ CLIParser::Flags SetUpCLI(char** args, int argc)
 
     return parser.Parse();
 }
+
+std::uint64_t ParseBytes(const std::string& flag, const std::string& text)
+{
+    if (text.empty())
+        return 0;
+
+    std::uint64_t bytes { 0 };
+    const char* const last { text.data()+text.size() };
+    auto [end, errc] { std::from_chars(text.data(), last, bytes) };
+
+    std::uint64_t unit { 1 };
+    if (errc == std::errc { } && end+1 == last)
+        switch (*end)
+        {
+            case 'K': case 'k': unit = std::uint64_t{1} << 10; end++; break;
+            case 'M': case 'm': unit = std::uint64_t{1} << 20; end++; break;
+            case 'G': case 'g': unit = std::uint64_t{1} << 30; end++; break;
+        }
+
+    if (errc != std::errc { } || end != last)
+        CRASH(System::ErrorCode::InvalidSpecifier, "--", flag, " takes bytes like 4096, 512K, 64M or 2G, not '", text, "'.");
+
+    return bytes*unit;
+}
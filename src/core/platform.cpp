@@ -1,5 +1,24 @@
+#include <algorithm>
+#include <csignal>
+#include <fstream>
+#include <string>
+#include <vector>
+
 #include "platform.hpp"
 
+#if defined(__linux__)
+    #include <sched.h>
+    #include <sys/syscall.h>
+    #if __has_include(<linux/mempolicy.h>)
+        #include <linux/mempolicy.h>
+    #endif
+#endif
+
+namespace
+{
+    volatile std::sig_atomic_t dumpRequested { 0 };
+}
+
 dlID_t DLLoad(std::string_view path)
 {
 #if defined(_WIN32) || defined(__CYGWIN__)
@@ -40,3 +59,231 @@ std::filesystem::path GetExePath()
 
     return std::filesystem::path { path };
 }
+
+std::size_t PageSize() noexcept
+{
+#if defined(_WIN32) || defined(__CYGWIN__)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#elif defined(unix) || defined(__unix) || defined(__unix__) || defined(__APPLE__) || defined(__MACH__)
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+void* MemReserve(std::size_t size) noexcept
+{
+#if defined(_WIN32) || defined(__CYGWIN__)
+    return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+#elif defined(unix) || defined(__unix) || defined(__unix__) || defined(__APPLE__) || defined(__MACH__)
+    void* memory { mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0) };
+    return memory == MAP_FAILED ? nullptr : memory;
+#endif
+}
+
+bool MemCommit(void* at, std::size_t size) noexcept
+{
+    if (size == 0)
+        return true;
+#if defined(_WIN32) || defined(__CYGWIN__)
+    return VirtualAlloc(at, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#elif defined(unix) || defined(__unix) || defined(__unix__) || defined(__APPLE__) || defined(__MACH__)
+    return mprotect(at, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+void MemRelease(void* at, std::size_t size) noexcept
+{
+    if (at == nullptr)
+        return;
+#if defined(_WIN32) || defined(__CYGWIN__)
+    VirtualFree(at, 0, MEM_RELEASE);
+#elif defined(unix) || defined(__unix) || defined(__unix__) || defined(__APPLE__) || defined(__MACH__)
+    munmap(at, size);
+#endif
+}
+
+void MemPrefault(void* at, std::size_t size) noexcept
+{
+#if defined(MADV_POPULATE_WRITE)
+    if (madvise(at, size, MADV_POPULATE_WRITE) == 0)
+        return;
+#endif
+    // fresh pages are zero, writing a zero faults them in as they are
+    volatile char* page { static_cast<char*>(at) };
+    const std::size_t step { PageSize() };
+    for (std::size_t offset = 0; offset < size; offset += step)
+        page[offset] = 0;
+}
+
+void MemHugePages(void* at, std::size_t size) noexcept
+{
+#if defined(MADV_HUGEPAGE)
+    madvise(at, size, MADV_HUGEPAGE);
+#endif
+}
+
+memsnap_t MemSnapshot(const void* at, std::size_t size) noexcept
+{
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+    const memsnap_t snapshot { memfd_create("csr-snapshot", MFD_CLOEXEC) };
+    if (snapshot < 0)
+        return InvalidSnapshot;
+    if (ftruncate(snapshot, static_cast<off_t>(size)) != 0)
+    {
+        close(snapshot);
+        return InvalidSnapshot;
+    }
+
+    // The file reads as zeros where nothing is written, skipping zero
+    // pages keeps the ones nobody touched out of it.
+    const char* const from { static_cast<const char*>(at) };
+    const std::size_t step { PageSize() };
+    for (std::size_t offset = 0; offset < size; offset += step)
+    {
+        const std::size_t length { std::min(step, size-offset) };
+        const char* const page { from+offset };
+        if (std::all_of(page, page+length, [](const char byte) { return byte == 0; }))
+            continue;
+
+        for (std::size_t written = 0; written < length; )
+        {
+            const ssize_t count { pwrite(snapshot, page+written, length-written, static_cast<off_t>(offset+written)) };
+            if (count <= 0)
+            {
+                close(snapshot);
+                return InvalidSnapshot;
+            }
+            written += static_cast<std::size_t>(count);
+        }
+    }
+
+    return snapshot;
+#else
+    return InvalidSnapshot;
+#endif
+}
+
+bool MemMapSnapshot(memsnap_t snapshot, void* at, std::size_t size) noexcept
+{
+    if (size == 0)
+        return true;
+#if defined(__linux__)
+    if (snapshot == InvalidSnapshot)
+        return false;
+    return mmap(at, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, snapshot, 0) != MAP_FAILED;
+#else
+    return false;
+#endif
+}
+
+void MemDropSnapshot(memsnap_t snapshot) noexcept
+{
+#if defined(__linux__)
+    // mappings keep the file alive
+    if (snapshot != InvalidSnapshot)
+        close(snapshot);
+#endif
+}
+
+int NumaNodes() noexcept
+{
+#if defined(__linux__)
+    // a list like "0" or "0-1", the last number is the highest node
+    std::ifstream online { "/sys/devices/system/node/online" };
+    std::string nodes;
+    if (!(online >> nodes))
+        return 1;
+
+    const std::size_t last { nodes.find_last_of(",-") };
+    const std::string highest { last == std::string::npos ? nodes : nodes.substr(last+1) };
+    return highest.find_first_not_of("0123456789") == std::string::npos && !highest.empty()
+        ? std::stoi(highest)+1
+        : 1;
+#else
+    return 1;
+#endif
+}
+
+int NumaNode() noexcept
+{
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu { 0 };
+    unsigned node { 0 };
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+        return static_cast<int>(node);
+#endif
+    return 0;
+}
+
+bool MemBindNode(void* at, std::size_t size, int node, bool move) noexcept
+{
+#if defined(__linux__) && defined(SYS_mbind) && defined(MPOL_MF_MOVE)
+    // preferred rather than bound, a full node spills over instead of failing
+    constexpr std::size_t bits { 8*sizeof(unsigned long) };
+    if (node < 0 || size == 0)
+        return false;
+
+    std::vector<unsigned long> mask(static_cast<std::size_t>(node)/bits+1);
+    mask[static_cast<std::size_t>(node)/bits] |= 1ul << (static_cast<std::size_t>(node)%bits);
+    return syscall(
+        SYS_mbind, at, size, MPOL_PREFERRED, mask.data(), mask.size()*bits+1, move ? MPOL_MF_MOVE : 0
+    ) == 0;
+#else
+    return false;
+#endif
+}
+
+bool PinThreadToNode(int node) noexcept
+{
+#if defined(__linux__) && defined(CPU_SET)
+    // a list like "0-3,8-11" of the node's cpus
+    std::ifstream list { "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist" };
+    std::string cpus;
+    if (node < 0 || !(list >> cpus))
+        return false;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    std::size_t at { 0 };
+    while (at < cpus.size())
+    {
+        std::size_t end { cpus.find(',', at) };
+        if (end == std::string::npos)
+            end = cpus.size();
+
+        const std::string range { cpus.substr(at, end-at) };
+        const std::size_t dash { range.find('-') };
+        if (range.empty() || range.find_first_not_of("0123456789-") != std::string::npos)
+            return false;
+
+        const int first { std::stoi(range.substr(0, dash)) };
+        const int last { dash == std::string::npos ? first : std::stoi(range.substr(dash+1)) };
+        for (int cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++)
+            CPU_SET(cpu, &set);
+
+        at = end+1;
+    }
+
+    return CPU_COUNT(&set) != 0 && sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+void WatchDumpSignal() noexcept
+{
+#if defined(SIGUSR1)
+    std::signal(SIGUSR1, [](int) { dumpRequested = 1; });
+#endif
+}
+
+bool DumpRequested() noexcept
+{
+    if (dumpRequested == 0)
+        return false;
+
+    dumpRequested = 0;
+    return true;
+}
@@ -0,0 +1,174 @@
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bytemode/board.hpp"
+#include "platform.hpp"
+#include "scheduler.hpp"
+#include "system.hpp"
+
+//
+// Scheduler Implementation
+//
+Scheduler::Scheduler(const sysbit_t threads, const bool numa) :
+    numa(numa)
+{
+    const int nodes { NumaNodes() };
+
+    for (sysbit_t i = 0; i < threads; i++)
+    {
+        this->workers.push_back(std::make_unique<Worker>());
+        this->workers.back()->node = numa ? static_cast<int>(i) % nodes : -1;
+    }
+
+    // worker 0 is whoever calls Run
+    if (numa)
+        PinThreadToNode(this->workers.front()->node);
+
+    for (std::size_t i = 1; i < this->workers.size(); i++)
+        this->workers[i]->thread = std::thread { &Scheduler::Work, this, i };
+}
+
+Scheduler::~Scheduler()
+{
+    {
+        std::lock_guard<std::mutex> guard { this->lock };
+        this->stopping = true;
+    }
+    this->wake.notify_all();
+
+    for (std::unique_ptr<Worker>& worker : this->workers)
+        if (worker->thread.joinable())
+            worker->thread.join();
+}
+
+void Scheduler::Run(const std::vector<Board*>& boards, const sysbit_t slice) noexcept
+{
+    if (boards.empty())
+        return;
+
+    // workers still looking for work from the last round may pick these
+    // up before they're woken, the deque locks publish both
+    const std::size_t count { this->workers.size() };
+    this->pending.store(boards.size(), std::memory_order_relaxed);
+    this->slice = slice;
+
+    for (std::size_t i = 0; i < boards.size(); i++)
+    {
+        // round-robin, over the workers on the board's node with --numa
+        std::size_t target { i % count };
+        if (this->numa && boards[i]->Node() >= 0)
+            for (std::size_t k = 0; k < count; k++)
+                if (this->workers[(target+k) % count]->node == boards[i]->Node())
+                {
+                    target = (target+k) % count;
+                    break;
+                }
+
+        Worker& worker { *this->workers[target] };
+        std::lock_guard<std::mutex> guard { worker.lock };
+        worker.tasks.push_back(boards[i]);
+    }
+
+    {
+        std::lock_guard<std::mutex> guard { this->lock };
+        this->round++;
+    }
+    this->wake.notify_all();
+
+    this->Drain(0);
+
+    std::unique_lock<std::mutex> guard { this->lock };
+    this->finished.wait(guard, [this] {
+        return this->pending.load(std::memory_order_acquire) == 0;
+    });
+}
+
+void Scheduler::Work(const std::size_t self) noexcept
+{
+    if (this->numa)
+        PinThreadToNode(this->workers[self]->node);
+
+    std::uint64_t seen { 0 };
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> guard { this->lock };
+            this->wake.wait(guard, [this, seen] { return this->stopping || this->round != seen; });
+
+            if (this->stopping)
+                return;
+
+            seen = this->round;
+        }
+
+        this->Drain(self);
+    }
+}
+
+void Scheduler::Drain(const std::size_t self) noexcept
+{
+    // nothing is added mid-round, once there's nothing to steal this
+    // worker is done
+    while (Board* board { this->Take(self) })
+    {
+        try_catch(
+            board->Run(this->slice);,
+
+            LOGE(
+                System::LogLevel::Low,
+                "Error while running ", board->Stringify()
+            );,
+
+            LOGE(
+                System::LogLevel::Medium,
+                "Fatal unexpected error while running board ", board->Stringify()
+            );
+        )
+
+        if (this->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            std::lock_guard<std::mutex> guard { this->lock };
+            this->finished.notify_all();
+        }
+    }
+}
+
+Board* Scheduler::Take(const std::size_t self) noexcept
+{
+    Worker& own { *this->workers[self] };
+    {
+        std::lock_guard<std::mutex> guard { own.lock };
+        if (!own.tasks.empty())
+        {
+            Board* board { own.tasks.front() };
+            own.tasks.pop_front();
+            return board;
+        }
+    }
+
+    // steal, from workers on the same node before the rest
+    const std::size_t count { this->workers.size() };
+    for (const bool local : { true, false })
+        for (std::size_t k = 1; k < count; k++)
+        {
+            Worker& victim { *this->workers[(self+k) % count] };
+            if ((victim.node == own.node) != local)
+                continue;
+
+            std::lock_guard<std::mutex> guard { victim.lock };
+            if (!victim.tasks.empty())
+            {
+                Board* board { victim.tasks.back() };
+                victim.tasks.pop_back();
+                return board;
+            }
+        }
+
+    return nullptr;
+}
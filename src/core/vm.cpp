@@ -1,5 +1,6 @@
 #include <cstdio>
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <limits>
 
@@ -10,9 +11,14 @@
 #include "CSRConfig.hpp"
 #include "platform.hpp"
 #include "message.hpp"
+#include "scheduler.hpp"
 #include "system.hpp"
 #include "vm.hpp"
 
+// Board::Run calls a board gets per round with --threads, enough to make
+// up for handing it to a worker
+static constexpr sysbit_t RoundSlice { 64 };
+
 //
 // VM Implementation
 //
@@ -188,9 +194,30 @@ Error VM::Setup(VM::VMSettings settings) noexcept
 
     set = true;
     this->settings = settings;
+
+#ifndef NDEBUG
+    // stepping runs a single instruction per input
+    if (this->settings.step)
+        this->settings.burst = 1;
+#endif
+
+    this->budget.SetLimit(this->settings.vmMemory);
+    if (this->settings.profile)
+        WatchDumpSignal();
+    if (this->settings.threads > 1)
+        this->scheduler = std::make_unique<Scheduler>(this->settings.threads, this->settings.numa);
     return Error::Ok;
 }
 
+int VM::BoardNode() noexcept
+{
+    if (this->scheduler == nullptr)
+        return NumaNode();
+
+    // spread the boards, the workers pinned to each node run its boards
+    return this->nextNode++ % NumaNodes();
+}
+
 Error VM::Run() noexcept
 {
     System::ErrorCode code = System::ErrorCode::Ok;
@@ -200,18 +227,26 @@ Error VM::Run() noexcept
         // Dispatch Messages
         code = this->DispatchMessages();
 
-        // Run the assemblies
+        if (this->settings.profile && DumpRequested())
+            for (const auto& [name, assembly] : this->assemblies)
+                assembly.DumpProfiles();
+
+        // Run the assemblies, with --threads they only settle here and
+        // the scheduler runs all their boards in one go
+        this->tasks.clear();
         for (auto& [name, assembly] : this->assemblies)
         {
             try_catch(
-                code = assembly.Run();
+                code = this->scheduler == nullptr ? assembly.Run() : assembly.Settle();
                 
                 if (code != System::ErrorCode::Ok)
                     LOGE(
                         System::LogLevel::Low,
                         "Error while running assembly ", assembly.Stringify(),
                         " Error code: ", System::ErrorCodeString(code) 
-                    );,
+                    );
+                else if (this->scheduler != nullptr)
+                    assembly.Schedule(this->tasks);,
 
                 LOGE(
                     System::LogLevel::Low, 
@@ -227,6 +262,9 @@ Error VM::Run() noexcept
             )
         }
 
+        if (this->scheduler != nullptr)
+            this->scheduler->Run(this->tasks, RoundSlice);
+
 #ifndef NDEBUG
         if (this->settings.step)
         {
@@ -0,0 +1,633 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#if defined(__x86_64__) && (defined(unix) || defined(__unix) || defined(__unix__))
+    #include <sys/mman.h>
+    #include <unistd.h>
+
+    #define JIT_SUPPORTED
+#endif
+
+#include "bytemode/instructions.hpp"
+#include "bytemode/stream.hpp"
+#include "bytemode/cpu.hpp"
+#include "extensions/converters.hpp"
+#include "jit/jit.hpp"
+#include "jit/x64.hpp"
+#include "CSRConfig.hpp"
+#include "system.hpp"
+#include "vm.hpp"
+
+// longest region translated in one go
+static constexpr sysbit_t MaxRegion { 256 };
+
+//
+// Host register assignment. The arguments stay where the calling
+// convention puts them, sp and the JASM registers eax..edi get callee-saved
+// or otherwise unused registers. rax, rcx and rdx are scratch.
+//
+static constexpr X64::Reg State { X64::rdi };
+static constexpr X64::Reg Ram { X64::rsi };
+static constexpr X64::Reg Budget { X64::r14 };
+static constexpr X64::Reg StackSize { X64::r15 };
+static constexpr X64::Reg Sp { X64::rbx };
+static constexpr X64::Reg Registers[] {
+    X64::r8, X64::r9, X64::r10, X64::r11, X64::r12, X64::r13
+};
+
+static constexpr X64::Reg Saved[] {
+    X64::rbx, X64::rbp, X64::r12, X64::r13, X64::r14, X64::r15
+};
+
+static X64::Mem Top(std::int32_t offset)
+{ return { Ram, Sp, offset }; }
+
+static X64::Mem Wide(sysbit_t slot)
+{ return { State, X64::none, static_cast<std::int32_t>(offsetof(CPU::State, wide) + slot*sizeof(sysbit_t)) }; }
+
+static X64::Mem Narrow(uchar_t reg)
+{
+    return {
+        State, X64::none,
+        static_cast<std::int32_t>(offsetof(CPU::State, narrow) + Enumc(reg)-Enumc(RegisterModeFlags::al))
+    };
+}
+
+// JASM eax..edi live in host registers, pc/sp/bp don't
+static bool Hosted(uchar_t reg)
+{ return reg >= Enumc(RegisterModeFlags::eax) && reg <= Enumc(RegisterModeFlags::edi); }
+
+static X64::Reg Host(uchar_t reg)
+{ return Registers[reg-Enumc(RegisterModeFlags::eax)]; }
+
+static bool Narrow8(uchar_t reg)
+{ return Is8BitReg(reg); }
+
+// Condition code of a cmp, false for the modes CompareVarious rejects.
+static bool Condition(uchar_t mode, bool isSigned, X64::Cond& cond)
+{
+    switch (CompareModeFlags(mode & 0b00011111))
+    {
+        case CompareModeFlags::les: cond = isSigned ? X64::l : X64::b; return true;
+        case CompareModeFlags::gre: cond = isSigned ? X64::g : X64::a; return true;
+        case CompareModeFlags::equ: cond = X64::e; return true;
+        case CompareModeFlags::leq: cond = isSigned ? X64::le : X64::be; return true;
+        case CompareModeFlags::geq: cond = isSigned ? X64::ge : X64::ae; return true;
+        case CompareModeFlags::neq: cond = X64::ne; return true;
+        default: return false;
+    }
+}
+
+//
+// JIT Implementation
+//
+bool JIT::Translatable(const Instruction& ins, sysbit_t& need, sysbit_t& grow) noexcept
+{
+    using Op = OpCodes;
+
+    need = grow = 0;
+
+    if (ins.handler == CPU::FoldedConstant)
+    {
+        // same room the handler asks for
+        grow = 8;
+        return true;
+    }
+
+    if (ins.handler == CPU::CompareJump)
+    {
+        X64::Cond cond { X64::e };
+        const NumericModeFlags numMode { static_cast<char>(ins.mode >> 5) };
+        if (numMode != NumericModeFlags::UInt && numMode != NumericModeFlags::Int)
+            return false;
+        if (!Condition(ins.mode, false, cond) || ins.target == InstructionStream::npos)
+            return false;
+
+        need = std::max<sysbit_t>(8, ins.imm2);
+        return true;
+    }
+
+    if (ins.dispatch == Instruction::Generic || ins.dispatch == Instruction::Yield)
+        return false;
+
+    // summarised by the verifier
+    if (ins.stackNeed == Instruction::Unproven || ins.stackGrow >= (1u << 30))
+        return false;
+
+    switch (ins.op)
+    {
+        case Op::nop:
+        case Op::stt: case Op::stts: case Op::ste: case Op::stes:
+        case Op::popt: case Op::pope:
+        case Op::dupt: case Op::dupe:
+        case Op::swpt: case Op::swpe:
+        case Op::addi: case Op::subi: case Op::muli:
+        case Op::addsi: case Op::subsi: case Op::mulsi:
+        case Op::inci: case Op::dcri:
+            return true;
+
+        case Op::cmp:
+        {
+            X64::Cond cond { X64::e };
+            const NumericModeFlags numMode { static_cast<char>(ins.mode >> 5) };
+            return (numMode == NumericModeFlags::UInt || numMode == NumericModeFlags::Int)
+                && Condition(ins.mode, false, cond);
+        }
+
+        case Op::jmp: case Op::cnd:
+            return ins.target != InstructionStream::npos;
+
+        case Op::movc:
+        case Op::rdr:
+            return Hosted(ins.reg1) || Narrow8(ins.reg1);
+
+        case Op::movs:
+        case Op::incri: case Op::dcrri:
+            return Hosted(ins.reg1);
+
+        case Op::incrb: case Op::dcrrb:
+            return Narrow8(ins.reg1);
+
+        case Op::movr: case Op::swpr:
+        case Op::addri: case Op::subri: case Op::mulri:
+        case Op::andr: case Op::orr:
+            return Hosted(ins.reg1) && Hosted(ins.reg2);
+
+        default:
+            return false;
+    }
+}
+
+JIT::JIT(const InstructionStream& stream, const std::string& name) :
+    stream(stream),
+    name(name),
+    regions(stream.Size()),
+    tried(stream.Size(), false),
+    heat(stream.Size(), 0)
+{
+    const VM::VMSettings& settings { VM::GetVM().GetSettings() };
+    this->threshold = static_cast<std::uint32_t>(settings.hotness);
+    this->report = settings.stats;
+}
+
+JIT::~JIT()
+{
+#ifdef JIT_SUPPORTED
+    for (const Block& block : this->blocks)
+        munmap(block.code, block.size);
+#endif
+}
+
+void JIT::Promote(sysbit_t index) noexcept
+{
+    std::lock_guard<std::mutex> guard { this->promoting };
+
+    // the counter wraps eventually and racing workers can both land on
+    // the threshold, translate once
+    if (this->tried[index])
+        return;
+
+    this->tried[index] = true;
+    const Region region { this->Compile(index) };
+    this->regions[index].store(region, std::memory_order_release);
+
+    if (!this->report)
+        return;
+
+    if (region != nullptr)
+        LOG(
+            this->name, " promoted pc ", std::to_string(this->stream[index].pc),
+            " to native after ", std::to_string(this->threshold), " calls/back-edges."
+        );
+    else
+        LOG(
+            this->name, " kept pc ", std::to_string(this->stream[index].pc),
+            " interpreted after ", std::to_string(this->threshold), " calls/back-edges, nothing there translates."
+        );
+}
+
+JIT::Region JIT::Compile(sysbit_t index) noexcept
+{
+#ifndef JIT_SUPPORTED
+    return nullptr;
+#else
+    // Collect the region first, jumps need to know what's in it.
+    std::vector<sysbit_t> region;
+    std::unordered_set<sysbit_t> members;
+    for (sysbit_t i = index; i != InstructionStream::npos && region.size() < MaxRegion; )
+    {
+        sysbit_t need, grow;
+        if (members.contains(i) || !Translatable(this->stream[i], need, grow))
+            break;
+
+        region.push_back(i);
+        members.insert(i);
+        i = this->stream[i].follow;
+    }
+
+    // not worth the entry and exit
+    if (region.size() < 2)
+        return nullptr;
+
+    std::unordered_set<sysbit_t> targets;
+    for (sysbit_t i : region)
+    {
+        const Instruction& ins { this->stream[i] };
+        const bool jumps {
+            ins.handler == CPU::CompareJump || ins.op == OpCodes::jmp || ins.op == OpCodes::cnd
+        };
+        if (jumps && members.contains(ins.target))
+            targets.insert(ins.target);
+    }
+
+    X64 x;
+
+    // Every way out stores its pc and goes through the epilogue.
+    std::vector<std::pair<X64::Patch, sysbit_t>> exits;
+    std::vector<std::pair<X64::Patch, sysbit_t>> forward;
+    std::unordered_map<sysbit_t, std::size_t> labels;
+
+    // Budget is charged in lumps, before anything that can leave.
+    sysbit_t pending { 0 };
+    const auto Charge { [&]() {
+        if (pending != 0)
+            x.Sub64(Budget, pending);
+        pending = 0;
+    }};
+
+    // Values in RAM are big endian unless built with NATIVE_ENDIAN_RAM
+    const auto RamSwap { [&](X64::Reg reg) {
+        if constexpr (RamEndian != std::endian::native)
+            x.Bswap(reg);
+    }};
+
+    const auto Exit { [&](X64::Patch patch, sysbit_t pc) {
+        exits.emplace_back(patch, pc);
+    }};
+
+    const auto JumpTo { [&](std::optional<X64::Cond> cond, const Instruction& ins) {
+        const sysbit_t target { ins.target };
+        const sysbit_t targetPc { this->stream[target].pc };
+
+        if (!members.contains(target))
+        {
+            Exit(cond ? x.J(*cond) : x.Jmp(), targetPc);
+            return;
+        }
+
+        if (!labels.contains(target))
+        {
+            forward.emplace_back(cond ? x.J(*cond) : x.Jmp(), target);
+            return;
+        }
+
+        // Backward, this is a loop. Stop once the budget runs out.
+        X64::Patch skip { 0 };
+        if (cond)
+            skip = x.J(static_cast<X64::Cond>(*cond ^ 1));
+        x.Test64(Budget, Budget);
+        Exit(x.J(X64::le), targetPc);
+        x.Jmp(labels.at(target));
+        if (cond)
+            x.Bind(skip, x.Here());
+    }};
+
+    // prologue
+    for (X64::Reg reg : Saved)
+        x.Push64(reg);
+    x.Mov64(Budget, X64::rdx);
+    x.Mov(StackSize, X64::rcx);
+    for (sysbit_t i = 0; i < std::size(Registers); i++)
+        x.Load(Registers[i], Wide(i));
+    x.Load(Sp, Wide(Enumc(RegisterModeFlags::sp)-Enumc(RegisterModeFlags::eax)));
+
+    bool chained { false };
+    for (std::size_t n = 0; n < region.size(); n++)
+    {
+        const sysbit_t i { region[n] };
+        const Instruction& ins { this->stream[i] };
+        const bool fused { ins.handler == CPU::FoldedConstant || ins.handler == CPU::CompareJump };
+
+        if (targets.contains(i))
+            Charge();
+        labels[i] = x.Here();
+
+        // Guard the stack once per run, same as CPU::RunBurst.
+        if (n == 0 || targets.contains(i) || !chained || fused)
+        {
+            sysbit_t need, grow;
+            Translatable(ins, need, grow);
+            if (!fused)
+            {
+                need = ins.stackNeed;
+                grow = ins.stackGrow;
+            }
+
+            Charge();
+            if (need != 0)
+            {
+                x.Cmp(Sp, need);
+                Exit(x.J(X64::b), ins.pc);
+            }
+            if (grow != 0)
+            {
+                x.Lea(X64::rax, { Sp, X64::none, static_cast<std::int32_t>(grow) });
+                x.Cmp(X64::rax, StackSize);
+                Exit(x.J(X64::a), ins.pc);
+            }
+        }
+        chained = ins.chained && !fused;
+
+        pending++;
+
+        if (ins.handler == CPU::FoldedConstant)
+        {
+            x.Store(Top(0), static_cast<std::uint32_t>(ins.imm));
+            x.Add(Sp, 4);
+            continue;
+        }
+
+        if (ins.handler == CPU::CompareJump || ins.op == OpCodes::cmp)
+        {
+            const bool isSigned { NumericModeFlags(static_cast<char>(ins.mode >> 5)) == NumericModeFlags::Int };
+            X64::Cond cond { X64::e };
+            Condition(ins.mode, isSigned, cond);
+
+            // charging the budget touches the flags, get it out of the way
+            if (ins.handler == CPU::CompareJump)
+                Charge();
+
+            x.Load(X64::rax, Top(-8));
+            RamSwap(X64::rax);
+            x.Load(X64::rcx, Top(-4));
+            RamSwap(X64::rcx);
+            x.Cmp(X64::rax, X64::rcx);
+            x.Set(cond, X64::rax);
+            x.Store8(Narrow(Enumc(RegisterModeFlags::bl)), X64::rax);
+
+            if (ins.handler == CPU::CompareJump)
+            {
+                // lea leaves the flags alone
+                if (ins.imm2 != 0)
+                    x.Lea(Sp, { Sp, X64::none, -static_cast<std::int32_t>(ins.imm2) });
+                JumpTo(cond, ins);
+            }
+            continue;
+        }
+
+        std::uint32_t raw;
+        switch (ins.op)
+        {
+            case OpCodes::nop:
+                break;
+
+            case OpCodes::stt: case OpCodes::stts:
+                raw = RamOrder(IntegerFromBytes<std::uint32_t>(ins.data));
+                x.Store(Top(0), raw);
+                x.Add(Sp, 4);
+                break;
+
+            case OpCodes::ste: case OpCodes::stes:
+                x.Store8(Top(0), static_cast<uchar_t>(ins.data[0]));
+                x.Add(Sp, 1);
+                break;
+
+            case OpCodes::popt: x.Sub(Sp, 4); break;
+            case OpCodes::pope: x.Sub(Sp, 1); break;
+
+            case OpCodes::dupt:
+                x.Load(X64::rax, Top(-4));
+                x.Store(Top(0), X64::rax);
+                x.Add(Sp, 4);
+                break;
+
+            case OpCodes::dupe:
+                x.Load8(X64::rax, Top(-1));
+                x.Store8(Top(0), X64::rax);
+                x.Add(Sp, 1);
+                break;
+
+            case OpCodes::swpt:
+                x.Load(X64::rax, Top(-8));
+                x.Load(X64::rcx, Top(-4));
+                x.Store(Top(-8), X64::rcx);
+                x.Store(Top(-4), X64::rax);
+                break;
+
+            case OpCodes::swpe:
+                x.Load8(X64::rax, Top(-2));
+                x.Load8(X64::rcx, Top(-1));
+                x.Store8(Top(-2), X64::rcx);
+                x.Store8(Top(-1), X64::rax);
+                break;
+
+            case OpCodes::addi: case OpCodes::subi: case OpCodes::muli:
+            case OpCodes::addsi: case OpCodes::subsi: case OpCodes::mulsi:
+            {
+                // lhs is below rhs
+                x.Load(X64::rax, Top(-8));
+                RamSwap(X64::rax);
+                x.Load(X64::rcx, Top(-4));
+                RamSwap(X64::rcx);
+
+                if (ins.op == OpCodes::addi || ins.op == OpCodes::addsi)
+                    x.Add(X64::rax, X64::rcx);
+                else if (ins.op == OpCodes::subi || ins.op == OpCodes::subsi)
+                    x.Sub(X64::rax, X64::rcx);
+                else
+                    x.Imul(X64::rax, X64::rcx);
+                RamSwap(X64::rax);
+
+                // the safe variants keep their operands
+                const bool keep { ins.op == OpCodes::addsi || ins.op == OpCodes::subsi || ins.op == OpCodes::mulsi };
+                x.Store(Top(keep ? 0 : -8), X64::rax);
+                if (keep)
+                    x.Add(Sp, 4);
+                else
+                    x.Sub(Sp, 4);
+                break;
+            }
+
+            case OpCodes::inci: case OpCodes::dcri:
+                x.Load(X64::rax, Top(-4));
+                RamSwap(X64::rax);
+                if (ins.op == OpCodes::inci)
+                    x.Add(X64::rax, ins.imm);
+                else
+                    x.Sub(X64::rax, ins.imm);
+                RamSwap(X64::rax);
+                x.Store(Top(-4), X64::rax);
+                break;
+
+            case OpCodes::jmp:
+                Charge();
+                JumpTo(std::nullopt, ins);
+                break;
+
+            case OpCodes::cnd:
+                Charge();
+                x.Cmp8(Narrow(Enumc(RegisterModeFlags::bl)), 0);
+                JumpTo(X64::ne, ins);
+                break;
+
+            case OpCodes::movc:
+                if (Narrow8(ins.reg1))
+                    x.Store8(Narrow(ins.reg1), static_cast<uchar_t>(ins.imm));
+                else
+                    x.Mov(Host(ins.reg1), ins.imm);
+                break;
+
+            case OpCodes::movr:
+                x.Mov(Host(ins.reg2), Host(ins.reg1));
+                break;
+
+            case OpCodes::movs:
+                x.Load(Host(ins.reg1), Top(-4));
+                RamSwap(Host(ins.reg1));
+                break;
+
+            case OpCodes::rdr:
+                if (Narrow8(ins.reg1))
+                {
+                    x.Load8(X64::rax, Narrow(ins.reg1));
+                    x.Store8(Top(0), X64::rax);
+                    x.Add(Sp, 1);
+                }
+                else
+                {
+                    x.Mov(X64::rax, Host(ins.reg1));
+                    RamSwap(X64::rax);
+                    x.Store(Top(0), X64::rax);
+                    x.Add(Sp, 4);
+                }
+                break;
+
+            case OpCodes::addri:
+                x.Add(Host(ins.reg2), Host(ins.reg1));
+                break;
+
+            case OpCodes::subri:
+                // reg2 = reg1 - reg2
+                x.Mov(X64::rax, Host(ins.reg1));
+                x.Sub(X64::rax, Host(ins.reg2));
+                x.Mov(Host(ins.reg2), X64::rax);
+                break;
+
+            case OpCodes::mulri:
+                x.Imul(Host(ins.reg2), Host(ins.reg1));
+                break;
+
+            case OpCodes::swpr:
+                x.Mov(X64::rax, Host(ins.reg1));
+                x.Mov(Host(ins.reg1), Host(ins.reg2));
+                x.Mov(Host(ins.reg2), X64::rax);
+                break;
+
+            case OpCodes::andr: case OpCodes::orr:
+                // BitLogic only takes the low byte of reg1
+                x.Mov(X64::rax, Host(ins.reg1));
+                x.And(X64::rax, 0xFF);
+                if (ins.op == OpCodes::andr)
+                    x.And(Host(ins.reg2), X64::rax);
+                else
+                    x.Or(Host(ins.reg2), X64::rax);
+                break;
+
+            case OpCodes::incri: x.Add(Host(ins.reg1), ins.imm); break;
+            case OpCodes::dcrri: x.Sub(Host(ins.reg1), ins.imm); break;
+
+            case OpCodes::incrb:
+                x.Add8(Narrow(ins.reg1), static_cast<uchar_t>(ins.imm));
+                break;
+            case OpCodes::dcrrb:
+                x.Add8(Narrow(ins.reg1), static_cast<uchar_t>(-ins.imm));
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    // Fell off the end of the region, the interpreter takes it from there.
+    Charge();
+    const Instruction& last { this->stream[region.back()] };
+    Exit(x.Jmp(), last.next);
+
+    for (const auto& [patch, target] : forward)
+        x.Bind(patch, labels.at(target));
+
+    // Exit stubs, one per pc, then the shared epilogue.
+    std::unordered_map<sysbit_t, std::size_t> stubs;
+    std::vector<X64::Patch> toEpilogue;
+    for (const auto& [patch, pc] : exits)
+    {
+        if (!stubs.contains(pc))
+        {
+            stubs[pc] = x.Here();
+            x.Store(Wide(Enumc(RegisterModeFlags::pc)-Enumc(RegisterModeFlags::eax)), pc);
+            toEpilogue.push_back(x.Jmp());
+        }
+        x.Bind(patch, stubs.at(pc));
+    }
+
+    for (X64::Patch patch : toEpilogue)
+        x.Bind(patch, x.Here());
+    for (sysbit_t i = 0; i < std::size(Registers); i++)
+        x.Store(Wide(i), Registers[i]);
+    x.Store(Wide(Enumc(RegisterModeFlags::sp)-Enumc(RegisterModeFlags::eax)), Sp);
+    x.Mov64(X64::rax, Budget);
+    for (std::size_t i = std::size(Saved); i-- > 0; )
+        x.Pop64(Saved[i]);
+    x.Ret();
+
+    return this->Install(x.Code(), this->stream[index].pc);
+#endif
+}
+
+JIT::Region JIT::Install(const std::vector<uchar_t>& code, sysbit_t pc) noexcept
+{
+#ifndef JIT_SUPPORTED
+    return nullptr;
+#else
+    const std::size_t page { static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) };
+    const std::size_t size { (code.size() + page - 1) / page * page };
+
+    // Written while it's writable, executed once it isn't.
+    void* memory { mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) };
+    if (memory == MAP_FAILED)
+    {
+        LOGW("JIT can't map memory for ", this->name, ", running it interpreted.");
+        return nullptr;
+    }
+
+    std::memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0)
+    {
+        munmap(memory, size);
+        LOGW("JIT can't make memory executable for ", this->name, ", running it interpreted.");
+        return nullptr;
+    }
+
+    this->blocks.push_back({ memory, size });
+
+    // Lets perf put names on JITed code, every assembly's JIT writes here
+    static std::mutex perfLock;
+    static std::ofstream perfMap {
+        "/tmp/perf-" + std::to_string(getpid()) + ".map",
+        std::ios::app
+    };
+    std::lock_guard<std::mutex> guard { perfLock };
+    perfMap << std::hex << reinterpret_cast<std::uintptr_t>(memory) << ' ' << code.size()
+            << std::dec << " jasm:" << this->name << ':' << pc << std::endl;
+
+    return reinterpret_cast<Region>(memory);
+#endif
+}
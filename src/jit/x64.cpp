@@ -0,0 +1,234 @@
+#include <initializer_list>
+
+#include "jit/x64.hpp"
+
+//
+// X64 Implementation
+//
+void X64::Dword(std::uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+        this->Byte(static_cast<uchar_t>(value >> (i*8)));
+}
+
+void X64::Rex(bool wide, uchar_t reg, uchar_t index, uchar_t base, bool force)
+{
+    const uchar_t rex {
+        static_cast<uchar_t>(
+            0x40
+            | (wide ? 0x08 : 0)
+            | (reg != none && reg & 8 ? 0x04 : 0)
+            | (index != none && index & 8 ? 0x02 : 0)
+            | (base != none && base & 8 ? 0x01 : 0)
+        )
+    };
+
+    if (rex != 0x40 || force)
+        this->Byte(rex);
+}
+
+void X64::Operand(uchar_t reg, Reg rm)
+{
+    this->Byte(0xC0 | (reg & 7) << 3 | (rm & 7));
+}
+
+void X64::Operand(uchar_t reg, Mem mem)
+{
+    // rbp/r13 as a base need a displacement, rsp/r12 need a SIB byte
+    const bool needsDisp { mem.disp != 0 || (mem.base & 7) == rbp };
+    const bool shortDisp { mem.disp >= -128 && mem.disp <= 127 };
+    const uchar_t mod { static_cast<uchar_t>(!needsDisp ? 0x00 : shortDisp ? 0x40 : 0x80) };
+
+    if (mem.index != none || (mem.base & 7) == rsp)
+    {
+        this->Byte(mod | (reg & 7) << 3 | 0x04);
+        this->Byte((mem.index == none ? 0x04 : mem.index & 7) << 3 | (mem.base & 7));
+    }
+    else
+        this->Byte(mod | (reg & 7) << 3 | (mem.base & 7));
+
+    if (!needsDisp)
+        return;
+
+    if (shortDisp)
+        this->Byte(static_cast<uchar_t>(mem.disp));
+    else
+        this->Dword(static_cast<std::uint32_t>(mem.disp));
+}
+
+void X64::MemOp(bool wide, std::initializer_list<uchar_t> opcode, uchar_t reg, Mem mem, bool byteReg)
+{
+    // spl/bpl/sil/dil need an empty REX to not mean ah/ch/dh/bh
+    this->Rex(wide, reg, mem.index, mem.base, byteReg && reg >= 4 && reg < 8);
+    for (uchar_t op : opcode)
+        this->Byte(op);
+    this->Operand(reg, mem);
+}
+
+void X64::RegOp(bool wide, std::initializer_list<uchar_t> opcode, uchar_t reg, Reg rm, bool byteReg)
+{
+    this->Rex(wide, reg, none, rm, byteReg && rm >= 4 && rm < 8);
+    for (uchar_t op : opcode)
+        this->Byte(op);
+    this->Operand(reg, rm);
+}
+
+void X64::Push64(Reg reg)
+{
+    this->Rex(false, none, none, reg);
+    this->Byte(0x50 | (reg & 7));
+}
+
+void X64::Pop64(Reg reg)
+{
+    this->Rex(false, none, none, reg);
+    this->Byte(0x58 | (reg & 7));
+}
+
+void X64::Ret()
+{ this->Byte(0xC3); }
+
+void X64::Mov(Reg to, Reg from)
+{ this->RegOp(false, {0x89}, from, to); }
+
+void X64::Mov(Reg to, std::uint32_t imm)
+{
+    this->Rex(false, none, none, to);
+    this->Byte(0xB8 | (to & 7));
+    this->Dword(imm);
+}
+
+void X64::Load(Reg to, Mem from)
+{ this->MemOp(false, {0x8B}, to, from); }
+
+void X64::Store(Mem to, Reg from)
+{ this->MemOp(false, {0x89}, from, to); }
+
+void X64::Store(Mem to, std::uint32_t imm)
+{
+    this->MemOp(false, {0xC7}, 0, to);
+    this->Dword(imm);
+}
+
+void X64::Load8(Reg to, Mem from)
+{ this->MemOp(false, {0x0F, 0xB6}, to, from); }
+
+void X64::Store8(Mem to, Reg from)
+{ this->MemOp(false, {0x88}, from, to, true); }
+
+void X64::Store8(Mem to, uchar_t imm)
+{
+    this->MemOp(false, {0xC6}, 0, to);
+    this->Byte(imm);
+}
+
+void X64::Add8(Mem to, uchar_t imm)
+{
+    this->MemOp(false, {0x80}, 0, to);
+    this->Byte(imm);
+}
+
+void X64::Cmp8(Mem lhs, uchar_t imm)
+{
+    this->MemOp(false, {0x80}, 7, lhs);
+    this->Byte(imm);
+}
+
+void X64::Add(Reg to, Reg from)
+{ this->RegOp(false, {0x01}, from, to); }
+
+void X64::Sub(Reg to, Reg from)
+{ this->RegOp(false, {0x29}, from, to); }
+
+void X64::Imul(Reg to, Reg from)
+{ this->RegOp(false, {0x0F, 0xAF}, to, from); }
+
+void X64::Cmp(Reg lhs, Reg rhs)
+{ this->RegOp(false, {0x39}, rhs, lhs); }
+
+void X64::And(Reg to, Reg from)
+{ this->RegOp(false, {0x21}, from, to); }
+
+void X64::Or(Reg to, Reg from)
+{ this->RegOp(false, {0x09}, from, to); }
+
+void X64::Add(Reg to, std::uint32_t imm)
+{
+    this->RegOp(false, {0x81}, 0, to);
+    this->Dword(imm);
+}
+
+void X64::Sub(Reg to, std::uint32_t imm)
+{
+    this->RegOp(false, {0x81}, 5, to);
+    this->Dword(imm);
+}
+
+void X64::Cmp(Reg lhs, std::uint32_t imm)
+{
+    this->RegOp(false, {0x81}, 7, lhs);
+    this->Dword(imm);
+}
+
+void X64::And(Reg to, std::uint32_t imm)
+{
+    this->RegOp(false, {0x81}, 4, to);
+    this->Dword(imm);
+}
+
+void X64::Lea(Reg to, Mem from)
+{ this->MemOp(false, {0x8D}, to, from); }
+
+void X64::Bswap(Reg reg)
+{
+    this->Rex(false, none, none, reg);
+    this->Byte(0x0F);
+    this->Byte(0xC8 | (reg & 7));
+}
+
+void X64::Set(Cond cond, Reg to)
+{ this->RegOp(false, {0x0F, static_cast<uchar_t>(0x90 | cond)}, 0, to, true); }
+
+void X64::Mov64(Reg to, Reg from)
+{ this->RegOp(true, {0x89}, from, to); }
+
+void X64::Sub64(Reg to, std::uint32_t imm)
+{
+    this->RegOp(true, {0x81}, 5, to);
+    this->Dword(imm);
+}
+
+void X64::Test64(Reg lhs, Reg rhs)
+{ this->RegOp(true, {0x85}, rhs, lhs); }
+
+X64::Patch X64::Jmp()
+{
+    this->Byte(0xE9);
+    this->Dword(0);
+    return this->Here();
+}
+
+X64::Patch X64::J(Cond cond)
+{
+    this->Byte(0x0F);
+    this->Byte(0x80 | cond);
+    this->Dword(0);
+    return this->Here();
+}
+
+void X64::Jmp(std::size_t target)
+{ this->Bind(this->Jmp(), target); }
+
+void X64::J(Cond cond, std::size_t target)
+{ this->Bind(this->J(cond), target); }
+
+void X64::Bind(Patch patch, std::size_t target)
+{
+    // rel32 is relative to the end of the jump, which is where the patch points
+    const std::uint32_t rel { static_cast<std::uint32_t>(
+        static_cast<std::int64_t>(target) - static_cast<std::int64_t>(patch)
+    )};
+
+    for (int i = 0; i < 4; i++)
+        this->code[patch-4+i] = static_cast<uchar_t>(rel >> (i*8));
+}